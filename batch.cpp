@@ -0,0 +1,120 @@
+//  ----------------------------------------------------------------------------
+//  Implementation file for the Batch class.                           batch.cpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#include "batch.hpp"
+
+#include "driver.hpp"
+#include "tools.hpp"
+#include "tractable.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+using namespace microsat;
+
+// -----------------------------------------------------------------------------
+// Collects the instances of a directory or a list file
+Batch::Batch(const std::string& source, Options options) : options(options) {
+    namespace fs = std::filesystem;
+    std::error_code error;
+    if (fs::is_directory(source, error)) {
+        for (auto& entry : fs::recursive_directory_iterator(source, error))
+            if (entry.is_regular_file())
+                files.push_back(entry.path().string());
+        std::sort(files.begin(), files.end());
+    } else {
+        std::ifstream in(source);
+        if (!in)
+            throw Fatal("can't open %s", source.c_str());
+        string line;
+        while (getline(in, line))
+            if (!line.empty() && line[0] != '#')
+                files.push_back(line);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Runs the instances on threads workers
+int Batch::run(int threads, bool stats) {
+    auto start = std::chrono::steady_clock::now();
+    if (threads < 1)
+        threads = 1;
+    std::vector<std::thread> pool;
+    for (int i = 1; i < threads; i++)
+        pool.emplace_back(&Batch::work, this);
+    work(); // The calling thread is the last worker
+    for (auto& thread : pool)
+        thread.join();
+    if (stats) {
+        std::chrono::duration<double> seconds =
+            std::chrono::steady_clock::now() - start;
+        std::ostringstream line;
+        line << "[ instances: " << files.size() << ", sat: " << solved[SAT]
+             << ", unsat: " << solved[UNSAT] << ", errors: " << errors
+             << ", threads: " << threads << ", seconds: " << seconds.count()
+             << " ]";
+        out.comment(line.str().c_str());
+    }
+    out.flush();
+    return errors ? 1 : 0;
+}
+
+// -----------------------------------------------------------------------------
+// Solves instances until the list is exhausted
+void Batch::work() {
+    std::unique_ptr<Solver> solver = nullptr; // reused by all instances
+    Formula formula;
+    for (std::size_t i; (i = next++) < files.size();)
+        solve(files[i], solver, formula);
+}
+
+// -----------------------------------------------------------------------------
+// Solves a single instance with the (reused) solver
+void Batch::solve(const std::string& file, std::unique_ptr<Solver>& solver,
+                  Formula& formula) {
+    auto start = std::chrono::steady_clock::now();
+    const char* status = "ERROR";
+    int result = -1;
+    try {
+        // The instances run in parallel: each one is parsed on one thread
+        Options serial = options;
+        serial.threads = 1;
+        result = driver::parse(file, solver, formula, serial);
+        if (result != UNSAT) {
+            // The fragments decided in linear time need no search
+            int decided = UNKNOWN;
+            if (driver::fastPath(formula, options)) {
+                Tractable tractable(formula);
+                Tractable::Fragment fragment = tractable.classify();
+                if (fragment != Tractable::Fragment::general)
+                    decided = tractable.solve(fragment, solver->model);
+            }
+            result = decided != UNKNOWN ? decided : solver->solve();
+        }
+        // Only report models that pass the check
+        if (result == SAT && formula.check(solver->model) >= 0)
+            result = -1;
+        if (result == SAT)
+            status = "SAT";
+        else if (result == UNSAT)
+            status = "UNSAT";
+    } catch (std::exception& e) {
+        // The solver may be left in any state; start over with a new one
+        solver = nullptr;
+    }
+    std::chrono::duration<double> seconds =
+        std::chrono::steady_clock::now() - start;
+    std::ostringstream line;
+    line << file << " " << status << " " << (solver ? solver->nConflicts : 0)
+         << " " << seconds.count() << "\n";
+    std::lock_guard<std::mutex> guard(lock);
+    out.text(line.str().c_str());
+    if (result == SAT || result == UNSAT)
+        solved[result]++;
+    else
+        errors++;
+}
@@ -0,0 +1,54 @@
+//  ----------------------------------------------------------------------------
+//  Header file for the Batch class.                                   batch.hpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#ifndef MICROSAT_BATCH_HPP
+#define MICROSAT_BATCH_HPP
+
+#include "formula.hpp"
+#include "solver.hpp"
+#include "writer.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace microsat {
+
+// -----------------------------------------------------------------------------
+// Solves many DIMACS files in one process. A fixed number of workers pull
+// instances from a shared list; every worker keeps its own solver and reuses
+// its arena for all the instances it solves. For each instance one line
+//     <file> <SAT|UNSAT|ERROR> <conflicts> <seconds>
+// is written to the result stream in the order of completion.
+class Batch {
+  private:
+    const Options options;            // Options of every solver
+    std::vector<std::string> files;   // The instances to solve
+    std::atomic<std::size_t> next{0}; // Index of the next unclaimed instance
+    std::mutex lock;                  // Serializes writes to out
+    Writer out;
+    int solved[2] = {0, 0}; // Number of UNSAT and SAT instances
+    int errors = 0;         // Number of instances that failed
+
+    // Solves instances until the list is exhausted
+    void work();
+    // Solves a single instance with the (reused) solver
+    void solve(const std::string& file, std::unique_ptr<Solver>& solver,
+               Formula& formula);
+
+  public:
+    // Collects the instances: every file in a directory (recursively) or
+    // every line of a list file
+    explicit Batch(const std::string& source, Options options = {});
+
+    // Runs the instances on threads workers; returns 0 iff no error occurred
+    int run(int threads, bool stats = false);
+};
+
+} // namespace microsat
+
+#endif // MICROSAT_BATCH_HPP
@@ -0,0 +1,451 @@
+//  ----------------------------------------------------------------------------
+//  Implementation file for the Bench class.                           bench.cpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#include "bench.hpp"
+#include "formula.hpp"
+#include "generator.hpp"
+#include "memory.hpp"
+#include "simd.hpp"
+#include "tools.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <utility>
+
+using namespace microsat;
+
+namespace {
+
+// -----------------------------------------------------------------------------
+// A solver of formula
+std::unique_ptr<Solver> build(const Formula& formula) {
+    auto s = std::make_unique<Solver>(formula.getVars(), formula.getClauses());
+    std::vector<int> clause;
+    for (int literal : formula.getLiterals())
+        if (literal) {
+            clause.push_back(literal);
+        } else {
+            if (s->addInput(clause.data(), (int)clause.size()) == UNSAT)
+                throw Fatal("the benchmark formula is unsatisfiable\n");
+            clause.clear();
+        }
+    if (s->simplify() == UNSAT)
+        throw Fatal("the benchmark formula is unsatisfiable\n");
+    return s;
+}
+
+// -----------------------------------------------------------------------------
+// Statistics of the seconds of the repetitions of a case
+struct Statistics {
+    double min, median, mean, stddev, max;
+
+    explicit Statistics(std::vector<double> seconds) {
+        std::sort(seconds.begin(), seconds.end());
+        std::size_t count = seconds.size(), middle = count / 2;
+        min = seconds.front();
+        max = seconds.back();
+        median = count % 2 ? seconds[middle]
+                           : (seconds[middle - 1] + seconds[middle]) / 2;
+        mean = 0;
+        for (double s : seconds)
+            mean += s / count;
+        double squares = 0;
+        for (double s : seconds)
+            squares += (s - mean) * (s - mean);
+        stddev = count > 1 ? std::sqrt(squares / (count - 1)) : 0;
+    }
+};
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+Bench::Bench(int reps, int warmup, std::string filter, std::uint64_t seed)
+    : reps(reps), warmup(warmup), filter(std::move(filter)), seed(seed),
+      state(seed | 1) {
+    if (reps < 1 || warmup < 0)
+        throw Fatal("at least one repetition is needed\n");
+}
+
+// -----------------------------------------------------------------------------
+// Returns the next pseudo-random number (xorshift64)
+std::uint64_t Bench::random() {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// -----------------------------------------------------------------------------
+// Runs a case: warmup untimed repetitions, then the timed ones
+void Bench::measure(const std::string& name, long long ops,
+                    const std::function<double()>& run) {
+    Result result;
+    result.name = name;
+    result.ops = ops;
+    for (int i = 0; i < warmup; i++)
+        run();
+    for (int i = 0; i < reps; i++)
+        result.seconds.push_back(run());
+    results.push_back(std::move(result));
+    std::fprintf(stderr, "c %s done\n", name.c_str());
+}
+
+// -----------------------------------------------------------------------------
+// The arena of the solver and the members the measured code changes
+Bench::State Bench::save(Solver& s) {
+    State state;
+    state.arena.assign(s.db, s.db + s.mem_used());
+    state.forced = s.forced - s.false_stack;
+    state.processed = s.processed - s.false_stack;
+    state.assigned = s.assigned - s.false_stack;
+    state.xor_processed = s.xor_processed - s.false_stack;
+    state.card_processed = s.card_processed - s.false_stack;
+    state.head = s.head;
+    state.nConflicts = s.nConflicts;
+    state.nLemmas = s.nLemmas;
+    state.maxLemmas = s.maxLemmas;
+    state.res = s.res;
+    state.fast = s.fast;
+    state.slow = s.slow;
+    state.target_size = s.target_size;
+    state.best_size = s.best_size;
+    state.mem_fixed = s.mem_fixed;
+    return state;
+}
+
+// -----------------------------------------------------------------------------
+void Bench::restore(Solver& s, const State& state) {
+    std::copy(state.arena.begin(), state.arena.end(), s.db);
+    s.mem.resize(state.arena.size());
+    s.forced = s.false_stack + state.forced;
+    s.processed = s.false_stack + state.processed;
+    s.assigned = s.false_stack + state.assigned;
+    s.xor_processed = s.false_stack + state.xor_processed;
+    s.card_processed = s.false_stack + state.card_processed;
+    s.head = state.head;
+    s.nConflicts = state.nConflicts;
+    s.nLemmas = state.nLemmas;
+    s.maxLemmas = state.maxLemmas;
+    s.res = state.res;
+    s.fast = state.fast;
+    s.slow = state.slow;
+    s.target_size = state.target_size;
+    s.best_size = state.best_size;
+    s.mem_fixed = state.mem_fixed;
+}
+
+// -----------------------------------------------------------------------------
+// Decides literal, as search() does
+void Bench::decide(Solver& s, int literal) {
+    s.false_[-literal] = 1;
+    s.model[std::abs(literal)] = (literal > 0);
+    *(s.assigned++) = -literal;
+    s.reason[std::abs(literal)] = 0;
+}
+
+// -----------------------------------------------------------------------------
+// Propagates the stack by scanning every clause until the fixpoint
+int* Bench::scan(Solver& s, const std::vector<int*>& clauses) {
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (int* clause : clauses) {
+            int free = -1, count = 0;
+            bool satisfied = false;
+            for (int i = 0; clause[i] && !satisfied; i++)
+                if (s.false_[-clause[i]])
+                    satisfied = true;
+                else if (!s.false_[clause[i]])
+                    free = i, count++;
+            if (satisfied || count > 1)
+                continue;
+            if (!count)
+                return clause; // Falsified
+            std::swap(clause[0], clause[free]); // The reason of a unit
+            s.assign(clause, 0);
+            changed = true;
+        }
+    }
+    s.processed = s.assigned;
+    return nullptr;
+}
+
+// -----------------------------------------------------------------------------
+// propagate() on fixed trails of random k-SAT: every variable is decided in
+// a fixed order with its value in a model, so that no conflict happens.
+// Every repetition starts from the watches of the input (repeating the
+// same trail would otherwise leave them on the true literals).
+void Bench::propagate(const std::string& name, int vars, int k,
+                      double ratio) {
+    Generator generator(seed);
+    auto s = build(generator.ksat(vars, k, ratio));
+    State input = save(*s);
+    if (s->solve() != SAT)
+        throw Fatal("the propagation formula is unsatisfiable\n");
+    std::vector<int> model(s->model, s->model + vars + 1);
+    std::vector<int> order;
+    for (int var = 1; var <= vars; var++)
+        order.push_back(var);
+    for (int i = vars - 1; i > 0; i--)
+        std::swap(order[i], order[random() % (i + 1)]);
+    long long ops = vars - input.assigned;
+    measure(name, ops, [&]() {
+        restore(*s, input);
+        double seconds = time([&]() {
+            for (int var : order)
+                if (!s->false_[var] && !s->false_[-var]) {
+                    decide(*s, model[var] ? var : -var);
+                    s->propagate();
+                }
+        });
+        if (s->nConflicts != input.nConflicts)
+            throw Fatal("propagate: a conflict on the trail\n");
+        return seconds;
+    });
+}
+
+// -----------------------------------------------------------------------------
+// analyze() on conflicts recorded after a short search (for its lemmas and
+// decision order): random decisions until one leads to a conflict
+void Bench::analyze(int vars, int count) {
+    Generator generator(seed);
+    auto s = build(generator.ksat(vars, 3, 4.26));
+    if (s->solve(4 * vars) == UNSAT)
+        throw Fatal("the conflict formula is unsatisfiable\n");
+    s->restart();
+    // The clauses, through their watches
+    std::vector<int*> clauses;
+    for (int literal = -vars; literal <= vars; literal++)
+        for (Ref watch = s->first[literal]; watch != END;
+             watch = s->link(watch))
+            clauses.push_back(s->literals(watch));
+    std::sort(clauses.begin(), clauses.end());
+    clauses.erase(std::unique(clauses.begin(), clauses.end()), clauses.end());
+    // Record the conflicts
+    std::vector<Conflict> conflicts;
+    while ((int)conflicts.size() < count) {
+        s->restart();
+        while (s->assigned - s->false_stack < vars) {
+            int var = 1 + (int)(random() % vars);
+            if (s->false_[var] || s->false_[-var])
+                continue;
+            int literal = random() & 1 ? var : -var;
+            State before = save(*s);
+            decide(*s, literal);
+            if (int* clause = scan(*s, clauses)) {
+                conflicts.push_back({save(*s), (Ref)(clause - s->db)});
+                restore(*s, before);
+                break;
+            }
+            restore(*s, before);
+            decide(*s, literal);
+            s->propagate(); // To the same fixpoint, without a conflict
+        }
+    }
+    measure("analyze", count, [&]() {
+        double seconds = 0;
+        for (const Conflict& conflict : conflicts) {
+            restore(*s, conflict.state);
+            seconds += time(
+                [&]() { sink += *s->analyze(s->db + conflict.clause); });
+        }
+        return seconds;
+    });
+}
+
+// -----------------------------------------------------------------------------
+// addClause() of lemmas, then reduceDB() removing them, from the same
+// formula every time
+void Bench::churn(int vars, int lemmas) {
+    Generator generator(seed);
+    auto s = build(generator.ksat(vars, 3, 4.0));
+    std::vector<std::vector<int>> added(lemmas);
+    for (auto& lemma : added) {
+        int size = 2 + (int)(random() % 11);
+        while ((int)lemma.size() < size) {
+            int var = 1 + (int)(random() % vars);
+            if (std::find(lemma.begin(), lemma.end(), var) == lemma.end() &&
+                std::find(lemma.begin(), lemma.end(), -var) == lemma.end())
+                lemma.push_back(random() & 1 ? var : -var);
+        }
+    }
+    State base = save(*s);
+    auto add = [&]() {
+        for (auto& lemma : added)
+            sink += *s->addClause(lemma.data(), (int)lemma.size(), 0);
+    };
+    measure("addClause", lemmas, [&]() {
+        restore(*s, base);
+        return time(add);
+    });
+    measure("reduceDB", lemmas, [&]() {
+        restore(*s, base);
+        add();
+        return time([&]() { s->reduceDB(); });
+    });
+}
+
+// -----------------------------------------------------------------------------
+// Memory, Allocator and FixedAllocator against std::allocator
+void Bench::allocators(int count) {
+    std::vector<int> sizes(count);
+    std::size_t total = 0;
+    for (int& size : sizes)
+        total += size = 3 + (int)(random() % 12); // Clause-like sizes
+    Memory<int> arena(std::max(total, (std::size_t)4 * count));
+    std::vector<int*> pointers(count);
+    measure("allocate/arena", count, [&]() {
+        arena.resize(0);
+        return time([&]() {
+            for (int size : sizes)
+                sink += *arena.allocate(size) = size;
+        });
+    });
+    measure("allocate/std::allocator", count, [&]() {
+        std::allocator<int> allocator;
+        return time([&]() {
+            for (int i = 0; i < count; i++)
+                sink += *(pointers[i] = allocator.allocate(sizes[i])) = i;
+            for (int i = 0; i < count; i++)
+                allocator.deallocate(pointers[i], sizes[i]);
+        });
+    });
+    measure("push_back/Allocator", count, [&]() {
+        arena.resize(0);
+        return time([&]() {
+            std::vector<int, Allocator<int>> v{Allocator<int>{arena}};
+            for (int i = 0; i < count; i++)
+                v.push_back(i);
+            sink += v.back();
+        });
+    });
+    measure("push_back/FixedAllocator", count, [&]() {
+        arena.resize(0);
+        int* fixed = arena.allocate(count);
+        return time([&]() {
+            auto v = Memory<int>::create_vector(fixed, count);
+            for (int i = 0; i < count; i++)
+                v.push_back(i);
+            sink += v.back();
+        });
+    });
+    measure("push_back/std::allocator", count, [&]() {
+        return time([&]() {
+            std::vector<int> v;
+            for (int i = 0; i < count; i++)
+                v.push_back(i);
+            sink += v.back();
+        });
+    });
+}
+
+// -----------------------------------------------------------------------------
+// step() of several solvers interleaved, round robin with varying budgets,
+// against solve() of each one alone: both searches must give the same
+// results after the same conflicts
+void Bench::steps(int solvers, int vars) {
+    std::vector<Formula> formulas;
+    std::vector<int> results, conflicts;
+    long long ops = 0;
+    for (int i = 0; i < solvers; i++) {
+        Generator generator(seed + i);
+        formulas.push_back(generator.ksat(vars, 3, 4.26));
+        auto s = build(formulas.back());
+        results.push_back(s->solve());
+        conflicts.push_back(s->nConflicts);
+        ops += s->nConflicts;
+    }
+    const int budgets[] = {1, 7, 100, 13};
+    measure("step", ops, [&]() {
+        std::vector<std::unique_ptr<Solver>> s;
+        for (const Formula& formula : formulas)
+            s.push_back(build(formula));
+        std::vector<int> stepped(solvers, UNKNOWN);
+        double seconds = time([&]() {
+            for (int round = 0, left = solvers; left; round++)
+                for (int i = 0; i < solvers; i++)
+                    if (stepped[i] == UNKNOWN) {
+                        stepped[i] = s[i]->step(budgets[(round + i) % 4]);
+                        left -= stepped[i] != UNKNOWN;
+                    }
+        });
+        for (int i = 0; i < solvers; i++)
+            if (stepped[i] != results[i] || s[i]->nConflicts != conflicts[i])
+                throw Fatal("step: solver %i differs from solve() (%i after "
+                            "%i conflicts, not %i after %i)\n",
+                            i, stepped[i], s[i]->nConflicts, results[i],
+                            conflicts[i]);
+        return seconds;
+    });
+}
+
+// -----------------------------------------------------------------------------
+// Runs the cases selected by the filter
+void Bench::run() {
+    auto selected = [&](const char* name) {
+        return filter.empty() ||
+               std::string(name).find(filter) != std::string::npos;
+    };
+    if (selected("propagate"))
+        propagate("propagate", 20000, 3, 3.0);
+    // Long clauses, with the vectorized and the scalar scan for the
+    // replacement watches
+    if (selected("propagate/long")) {
+        propagate("propagate/long", 5000, 40, 60);
+        selectScan(false);
+        propagate("propagate/long-scalar", 5000, 40, 60);
+        selectScan(true);
+    }
+    if (selected("analyze"))
+        analyze(300, 256);
+    if (selected("addClause") || selected("reduceDB"))
+        churn(5000, 20000);
+    if (selected("allocate") || selected("push_back"))
+        allocators(1 << 20);
+    if (selected("step"))
+        steps(8, 100);
+}
+
+// -----------------------------------------------------------------------------
+// Writes a table of the results to out
+void Bench::report(std::ostream& out) const {
+    char line[160];
+    std::snprintf(line, sizeof line, "%-26s %10s %12s %12s %8s %12s\n",
+                  "case", "ops", "median ms", "min ms", "stddev", "ns/op");
+    out << line;
+    for (const Result& result : results) {
+        Statistics stats(result.seconds);
+        std::snprintf(line, sizeof line,
+                      "%-26s %10lld %12.3f %12.3f %7.1f%% %12.1f\n",
+                      result.name.c_str(), result.ops, stats.median * 1e3,
+                      stats.min * 1e3, 100 * stats.stddev / stats.mean,
+                      stats.median * 1e9 / std::max(result.ops, 1LL));
+        out << line;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Writes the results as JSON to out (times in nanoseconds)
+void Bench::json(std::ostream& out) const {
+    out << "{\n  \"reps\": " << reps << ",\n  \"warmup\": " << warmup
+        << ",\n  \"seed\": " << seed << ",\n  \"benchmarks\": [";
+    char line[512];
+    for (std::size_t i = 0; i < results.size(); i++) {
+        const Result& result = results[i];
+        Statistics stats(result.seconds);
+        std::snprintf(
+            line, sizeof line,
+            "%s\n    {\"name\": \"%s\", \"ops\": %lld, \"min_ns\": %.0f, "
+            "\"median_ns\": %.0f, \"mean_ns\": %.0f, \"stddev_ns\": %.0f, "
+            "\"max_ns\": %.0f, \"ns_per_op\": %.2f}",
+            i ? "," : "", result.name.c_str(), result.ops, stats.min * 1e9,
+            stats.median * 1e9, stats.mean * 1e9, stats.stddev * 1e9,
+            stats.max * 1e9, stats.median * 1e9 / std::max(result.ops, 1LL));
+        out << line;
+    }
+    out << "\n  ]\n}\n";
+}
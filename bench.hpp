@@ -0,0 +1,108 @@
+//  ----------------------------------------------------------------------------
+//  Header file for the Bench class.                                   bench.hpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#ifndef MICROSAT_BENCH_HPP
+#define MICROSAT_BENCH_HPP
+
+#include "solver.hpp"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace microsat {
+
+// -----------------------------------------------------------------------------
+// Microbenchmarks of the hot paths of the solver and of its arena: every
+// case is repeated after a few untimed warmup runs, each repetition timed
+// with the steady clock around the measured code only (its setup, such as
+// restoring the arena, is left out), and reported as statistics over the
+// repetitions. Bench is a friend of the solver to set up the trails and
+// conflicts it measures on.
+class Bench {
+  public:
+    // The timings of a case
+    struct Result {
+        std::string name;
+        long long ops = 0;            // Operations per repetition
+        std::vector<double> seconds;  // Of every repetition
+    };
+
+  private:
+    // The state of a solver, to measure from it again: its arena and the
+    // members outside it that the measured code changes
+    struct State {
+        std::vector<int> arena;
+        long forced = 0, processed = 0, assigned = 0; // Offsets in the
+        long xor_processed = 0, card_processed = 0;   // stack
+        int head = 0, nConflicts = 0, nLemmas = 0, maxLemmas = 0, res = 0;
+        int fast = 0, slow = 0, target_size = 0, best_size = 0;
+        Ref mem_fixed = 0;
+    };
+    // A conflict recorded for analyze(): the state and the falsified clause
+    struct Conflict {
+        State state;
+        Ref clause = 0; // Offset of the clause in the arena
+    };
+
+    int reps;                          // Timed repetitions of each case
+    int warmup;                        // Untimed ones before
+    std::string filter;                // Only the cases of which the name
+                                       // contains it (all if empty)
+    std::uint64_t seed;                // Seed of the generated formulas
+    std::uint64_t state;               // State of the random generator
+    std::vector<Result> results;
+    volatile std::uint64_t sink = 0;   // Keeps the results of the measured
+                                       // code alive
+
+    // Returns the next pseudo-random number (xorshift64)
+    std::uint64_t random();
+    // Runs a case: run() performs one repetition and returns its seconds
+    void measure(const std::string& name, long long ops,
+                 const std::function<double()>& run);
+    // The seconds f takes
+    template <class F> static double time(F&& f) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double> seconds =
+            std::chrono::steady_clock::now() - start;
+        return seconds.count();
+    }
+
+    static State save(Solver& s);
+    static void restore(Solver& s, const State& state);
+    // Decides literal, as search() does
+    static void decide(Solver& s, int literal);
+    // Propagates the stack by scanning clauses (the arena pointers of every
+    // clause) instead of the watches, stopping at the first falsified
+    // clause, which it returns (nullptr at the fixpoint). The implied
+    // literals are swapped to the front of their reasons, which breaks the
+    // watches: the state is to be restored afterwards.
+    static int* scan(Solver& s, const std::vector<int*>& clauses);
+
+    // The cases
+    void propagate(const std::string& name, int vars, int k, double ratio);
+    void analyze(int vars, int count);
+    void churn(int vars, int lemmas);
+    void allocators(int count);
+    void steps(int solvers, int vars);
+
+  public:
+    Bench(int reps, int warmup, std::string filter, std::uint64_t seed);
+
+    // Runs the cases
+    void run();
+    // Writes a table of the results to out
+    void report(std::ostream& out) const;
+    // Writes the results as JSON to out
+    void json(std::ostream& out) const;
+};
+
+} // namespace microsat
+
+#endif // MICROSAT_BENCH_HPP
@@ -18,7 +18,7 @@ fi
 
 for i in $(cat name3); do
   $solver ../../bench2/sat/$i >results 2>&1
-  if (grep -q "[^n]sat" results) || (grep -q "^sat" results); then
+  if grep -q "^s SATISFIABLE" results; then
     echo "$i Pass!"
     let "c+=1"
     let "s+=1"
@@ -35,7 +35,7 @@ done
 
 for i in $(cat name4); do
   $solver ../../bench2/unsat/$i >results 2>&1
-  if grep -q "unsat" results; then
+  if grep -q "^s UNSATISFIABLE" results; then
     echo "$i Pass!"
     let "c+=1"
     let "s+=1"
@@ -18,7 +18,7 @@ fi
 
 for i in $(cat name5); do
   $solver ../../bench3/$i >results 2>&1
-  if grep -q "unsat" results; then
+  if grep -q "^s UNSATISFIABLE" results; then
     echo "$i Pass!"
     let "c+=1"
     let "s+=1"
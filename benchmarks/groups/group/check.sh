@@ -0,0 +1,23 @@
+# Sourced by the scripts that check models
+
+# Whether the v lines of $2 satisfy every clause of the formula $1
+check() {
+  awk 'NR == FNR {
+         if ($1 == "v")
+           for (i = 2; i <= NF; i++)
+             true_[$i] = 1
+         next
+       }
+       $1 == "c" || $1 == "p" || $1 == "%" { next }
+       {
+         for (i = 1; i <= NF; i++)
+           if ($i == 0) {
+             if (!satisfied)
+               falsified++
+             satisfied = 0
+           } else if ($i in true_) {
+             satisfied = 1
+           }
+       }
+       END { exit falsified > 0 }' "$2" "$1"
+}
@@ -0,0 +1,69 @@
+#!/bin/bash
+
+# MaxSAT (--maxsat): each line of name8 is a wcnf of the maxsat folder and
+# its optimum ("-" if the hard clauses are unsat). The last "o" line must
+# be the optimum, the exit code 30 (20 if unsat), and the model must
+# satisfy the hard clauses at that cost. php8x12 needs enough conflicts to
+# reduce the lemmas between the cores.
+
+START=$(date +%s)
+c=0
+s=0
+w=0
+solver="../../.././microsat++ --maxsat -f "
+
+# The cost of the model of $2 in the wcnf $1, "hard" if it falsifies a hard
+# clause (one clause per line)
+cost() {
+  awk 'NR == FNR {
+         if ($1 == "v")
+           for (i = 2; i <= NF; i++)
+             true_[$i] = 1
+         next
+       }
+       $1 == "c" || NF == 0 { next }
+       $1 == "p" { top = $5; next }
+       {
+         satisfied = 0
+         for (i = 2; i <= NF && $i != 0; i++)
+           if ($i in true_)
+             satisfied = 1
+         if (satisfied)
+           next
+         if ($1 == "h" || (top != "" && $1 + 0 >= top + 0))
+           hard = 1
+         else
+           sum += $1
+       }
+       END { if (hard) print "hard"; else print sum + 0 }' "$2" "$1"
+}
+
+while read -r i optimum; do
+  $solver ../../maxsat/$i >results 2>&1
+  code=$?
+  ok=1
+  if [ "$optimum" = "-" ]; then
+    [ $code = 20 ] && grep -q "^s UNSATISFIABLE" results || ok=0
+  else
+    [ $code = 30 ] && grep -q "^s OPTIMUM FOUND" results || ok=0
+    [ "$(grep "^o " results | tail -1)" = "o $optimum" ] || ok=0
+    [ "$(cost ../../maxsat/$i results)" = "$optimum" ] || ok=0
+  fi
+  let "s+=1"
+  if [ $ok = 1 ]; then
+    echo "$i Pass!"
+    let "c+=1"
+  else
+    echo "$i Wrong!"
+    let "w+=1"
+  fi
+
+  rm -f results
+done <name8
+
+echo "-------- Your Result --------"
+echo "Pass: $c/$s"
+
+END=$(date +%s)
+DIFF=$(($END - $START))
+echo "Took $DIFF seconds."
@@ -0,0 +1,52 @@
+#!/bin/bash
+
+# Model enumeration (--all): each line of name7 is a cnf of the models
+# folder and its number of models (projected on the "c p show" variables,
+# if any). The models must be as many, all different, and each one
+# satisfies the formula (when not projected).
+
+START=$(date +%s)
+c=0
+s=0
+w=0
+solver="../../.././microsat++ --all -f "
+
+. ./check.sh
+
+while read -r i count; do
+  $solver ../../models/$i >results 2>&1
+  code=$?
+  ok=1
+  grep "^v" results >models
+  if [ "$(wc -l <models)" != "$count" ] ||
+     [ -n "$(sort models | uniq -d)" ]; then
+    ok=0
+  elif [ "$count" = 0 ]; then
+    [ $code = 20 ] && grep -q "^s UNSATISFIABLE" results || ok=0
+  else
+    [ $code = 10 ] && grep -q "^s SATISFIABLE" results || ok=0
+    if ! grep -q "^c p show" ../../models/$i; then
+      while read -r model; do
+        echo "$model" >model
+        check ../../models/$i model || ok=0
+      done <models
+    fi
+  fi
+  let "s+=1"
+  if [ $ok = 1 ]; then
+    echo "$i Pass!"
+    let "c+=1"
+  else
+    echo "$i Wrong!"
+    let "w+=1"
+  fi
+
+  rm -f results models model
+done <name7
+
+echo "-------- Your Result --------"
+echo "Pass: $c/$s"
+
+END=$(date +%s)
+DIFF=$(($END - $START))
+echo "Took $DIFF seconds."
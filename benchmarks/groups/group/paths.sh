@@ -0,0 +1,48 @@
+#!/bin/bash
+
+# Every path must give the same answer: with and without the fast paths
+# (2-CNF, Horn, units), and with symmetry breaking. The models are checked
+# against the formula here, not only by the solver.
+
+START=$(date +%s)
+c=0
+s=0
+w=0
+solver="../../.././microsat++"
+paths=("" "--no-fast-paths" "--symmetry" "--symmetry --no-fast-paths")
+
+. ./check.sh
+
+for i in $(cat name6); do
+  expected=""
+  ok=1
+  for options in "${paths[@]}"; do
+    $solver $options -f ../../paths/$i >results 2>&1
+    status=$(grep "^s " results)
+    if [ -z "$expected" ]; then
+      expected=$status
+    fi
+    if [ -z "$status" ] || [ "$status" != "$expected" ]; then
+      ok=0
+    elif [ "$status" = "s SATISFIABLE" ] && ! check ../../paths/$i results; then
+      ok=0
+    fi
+  done
+  let "s+=1"
+  if [ $ok = 1 ]; then
+    echo "$i Pass!"
+    let "c+=1"
+  else
+    echo "$i Wrong!"
+    let "w+=1"
+  fi
+
+  rm -f results
+done
+
+echo "-------- Your Result --------"
+echo "Pass: $c/$s"
+
+END=$(date +%s)
+DIFF=$(($END - $START))
+echo "Took $DIFF seconds."
@@ -0,0 +1,50 @@
+#!/bin/bash
+
+# Snapshot round trips: every cnf of bench1 and paths is solved while its
+# snapshot is dumped (--dump-snapshot), then from the snapshot
+# (--load-snapshot), with and without symmetry breaking. Both answers must
+# be the same, and the models are checked against the formula.
+
+START=$(date +%s)
+c=0
+s=0
+w=0
+solver="../../.././microsat++"
+paths=("" "--symmetry")
+
+. ./check.sh
+
+files=$(sed 's|^|../../bench1/sat/|' name1; sed 's|^|../../bench1/unsat/|' name2;
+        sed 's|^|../../paths/|' name6)
+
+for i in $files; do
+  ok=1
+  for options in "${paths[@]}"; do
+    $solver $options --dump-snapshot snapshot -f $i >dumped 2>&1
+    $solver $options --load-snapshot snapshot >loaded 2>&1
+    status=$(grep "^s " dumped)
+    if [ -z "$status" ] || [ "$status" != "$(grep "^s " loaded)" ]; then
+      ok=0
+    elif [ "$status" = "s SATISFIABLE" ] &&
+         ! { check $i dumped && check $i loaded; }; then
+      ok=0
+    fi
+  done
+  let "s+=1"
+  if [ $ok = 1 ]; then
+    echo "$(basename $i) Pass!"
+    let "c+=1"
+  else
+    echo "$(basename $i) Wrong!"
+    let "w+=1"
+  fi
+
+  rm -f snapshot dumped loaded
+done
+
+echo "-------- Your Result --------"
+echo "Pass: $c/$s"
+
+END=$(date +%s)
+DIFF=$(($END - $START))
+echo "Took $DIFF seconds."
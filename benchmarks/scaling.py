@@ -0,0 +1,240 @@
+#!/usr/bin/env python3
+# -----------------------------------------------------------------------------
+# Scaling sweep: generates the instance families of microsat-gen at growing
+# sizes, solves them with microsat++ and fits how time, conflicts per second
+# and memory grow with n. A constant-factor slowdown moves the curves; an
+# asymptotic one changes the fitted growth, which --baseline compares against
+# an earlier sweep (for example one of the last release):
+#
+#   benchmarks/scaling.py --csv base.csv                  # once
+#   benchmarks/scaling.py --baseline base.csv --plot s.png
+#
+# The fit is a power law (time ~ n^b) or an exponential (time ~ e^(b n)),
+# whichever fits the medians better; plotting needs matplotlib (otherwise
+# the table is printed only).
+# -----------------------------------------------------------------------------
+
+import argparse
+import csv
+import math
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import time
+
+# The families: sizes swept and microsat-gen arguments
+FAMILIES = {
+    "ksat": ([50, 75, 100, 125, 150, 175], ["--ratio", "4.26"]),
+    "php": ([5, 6, 7, 8, 9], []),
+    "parity": ([50, 100, 200, 400, 800], []),
+    "color": ([100, 200, 400, 800, 1600], ["--degree", "4"]),
+}
+STATS = re.compile(r"mem_used: (\d+), conflicts: (\d+)")
+
+
+def run(command, timeout):
+    """Runs command; returns (seconds, peak RSS in KB, stdout, timed out)"""
+    start = time.perf_counter()
+    with tempfile.TemporaryFile() as out:
+        child = subprocess.Popen(command, stdout=out, stderr=subprocess.DEVNULL)
+        deadline = start + timeout
+        while True:
+            pid, status, usage = os.wait4(child.pid, os.WNOHANG)
+            if pid:
+                break
+            if time.perf_counter() > deadline:
+                child.kill()
+                pid, status, usage = os.wait4(child.pid, 0)
+                return timeout, usage.ru_maxrss, "", True
+            time.sleep(0.002)
+        seconds = time.perf_counter() - start
+        out.seek(0)
+        return seconds, usage.ru_maxrss, out.read().decode(), False
+
+
+def solve(args, family, n, seed, extra, path):
+    """Generates and solves one instance; returns its measurements"""
+    gen = [args.gen, family, str(n), "--seed", str(seed), "-o", path]
+    subprocess.run(gen + extra, check=True, stdout=subprocess.DEVNULL)
+    command = [args.solver, "-s", "-f", path] + args.solver_args
+    seconds, rss, out, timed_out = run(command, args.timeout)
+    match = STATS.search(out)
+    mem, conflicts = (int(match.group(1)), int(match.group(2))) if match \
+        else (0, 0)
+    status = "TIMEOUT" if timed_out else \
+        next((l[2:] for l in out.splitlines() if l.startswith("s ")), "?")
+    return {"family": family, "n": n, "seed": seed, "status": status,
+            "seconds": seconds, "conflicts": conflicts,
+            "conflicts_per_second": conflicts / max(seconds, 1e-6),
+            "arena_bytes": 4 * mem, "rss_kb": rss}
+
+
+def median(values):
+    values = sorted(values)
+    middle = len(values) // 2
+    return values[middle] if len(values) % 2 else \
+        (values[middle - 1] + values[middle]) / 2
+
+
+def fit(xs, ys):
+    """Least squares y = a + b x; returns (a, b, r2)"""
+    count = len(xs)
+    mx, my = sum(xs) / count, sum(ys) / count
+    sxx = sum((x - mx) ** 2 for x in xs)
+    sxy = sum((x - mx) * (y - my) for x, y in zip(xs, ys))
+    syy = sum((y - my) ** 2 for y in ys)
+    b = sxy / sxx if sxx else 0.0
+    r2 = sxy * sxy / (sxx * syy) if sxx and syy else 1.0
+    return my - b * mx, b, r2
+
+
+def growth(ns, values):
+    """The better of the power-law and exponential fits of values against
+    ns: ("power", exponent, r2) or ("exp", rate per unit of n, r2)"""
+    points = [(n, v) for n, v in zip(ns, values) if v > 0]
+    if len(points) < 3:
+        return ("none", 0.0, 0.0)
+    logs = [math.log(v) for _, v in points]
+    _, power, r2_power = fit([math.log(n) for n, _ in points], logs)
+    _, rate, r2_exp = fit([n for n, _ in points], logs)
+    return ("exp", rate, r2_exp) if r2_exp > r2_power else \
+        ("power", power, r2_power)
+
+
+def summarize(rows):
+    """Median of every metric per family and size, and the fits per family"""
+    table, fits = {}, {}
+    for row in rows:
+        table.setdefault(row["family"], {}).setdefault(row["n"], []).append(row)
+    for family, sizes in table.items():
+        ns = sorted(sizes)
+        medians = {metric: [median([r[metric] for r in sizes[n]]) for n in ns]
+                   for metric in ("seconds", "conflicts_per_second",
+                                  "arena_bytes", "rss_kb")}
+        fits[family] = (ns, medians,
+                        {m: growth(ns, v) for m, v in medians.items()})
+    return fits
+
+
+def report(fits):
+    for family, (ns, medians, growths) in sorted(fits.items()):
+        print("\n%s" % family)
+        print("%8s %10s %14s %14s %10s" %
+              ("n", "seconds", "conflicts/s", "arena bytes", "rss KB"))
+        for i, n in enumerate(ns):
+            print("%8d %10.3f %14.0f %14.0f %10.0f" %
+                  (n, medians["seconds"][i], medians["conflicts_per_second"][i],
+                   medians["arena_bytes"][i], medians["rss_kb"][i]))
+        for metric, (kind, b, r2) in sorted(growths.items()):
+            law = "n^%.2f" % b if kind == "power" else "e^(%.4f n)" % b
+            print("  %-22s ~ %-14s (r2 %.3f)" % (metric, law, r2))
+
+
+def plot(fits, path):
+    try:
+        import matplotlib
+        matplotlib.use("Agg")
+        import matplotlib.pyplot as plt
+    except ImportError:
+        print("matplotlib is not installed: no plot", file=sys.stderr)
+        return
+    metrics = ("seconds", "conflicts_per_second", "rss_kb")
+    figure, axes = plt.subplots(1, len(metrics), figsize=(15, 4.5))
+    for axis, metric in zip(axes, metrics):
+        for family, (ns, medians, _) in sorted(fits.items()):
+            axis.plot(ns, medians[metric], marker="o", label=family)
+        axis.set_xscale("log")
+        axis.set_yscale("log")
+        axis.set_xlabel("n")
+        axis.set_title(metric.replace("_", " "))
+        axis.legend()
+    figure.tight_layout()
+    figure.savefig(path)
+    print("plot written to %s" % path)
+
+
+def compare(fits, path, tolerance):
+    """Flags the families whose time or memory grows faster than in the
+    baseline sweep; returns whether there is none"""
+    with open(path) as f:
+        base = summarize([dict(r, n=int(r["n"]), **{
+            k: float(r[k]) for k in ("seconds", "conflicts_per_second",
+                                     "arena_bytes", "rss_kb")})
+            for r in csv.DictReader(f)])
+    ok = True
+    for family, (_, _, growths) in sorted(fits.items()):
+        if family not in base:
+            continue
+        for metric in ("seconds", "arena_bytes"):
+            kind, b, _ = growths[metric]
+            base_kind, base_b, _ = base[family][2][metric]
+            if kind == base_kind and b > base_b * (1 + tolerance) + 1e-9:
+                print("REGRESSION %s %s: growth %.4f, baseline %.4f (%s)" %
+                      (family, metric, b, base_b, kind))
+                ok = False
+            elif kind != base_kind and kind == "exp":
+                print("REGRESSION %s %s: exponential growth, baseline %s" %
+                      (family, metric, base_kind))
+                ok = False
+    if ok:
+        print("no asymptotic regression")
+    return ok
+
+
+def main():
+    root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    parser = argparse.ArgumentParser(
+        description="Scaling sweep of microsat++ over generated families")
+    parser.add_argument("--solver", default=os.path.join(root, "microsat++"))
+    parser.add_argument("--gen", default=os.path.join(root, "microsat-gen"))
+    parser.add_argument("--families", default=",".join(FAMILIES),
+                        help="comma separated: " + ", ".join(FAMILIES))
+    parser.add_argument("--sizes", action="append", default=[],
+                        metavar="FAMILY=N,N,...", help="sizes of a family")
+    parser.add_argument("--seeds", type=int, default=3,
+                        help="instances per size (the medians are fitted)")
+    parser.add_argument("--timeout", type=float, default=60)
+    parser.add_argument("--csv", help="write the measurements")
+    parser.add_argument("--plot", help="write the plot (png)")
+    parser.add_argument("--baseline", help="measurements of an earlier sweep")
+    parser.add_argument("--tolerance", type=float, default=0.25,
+                        help="growth allowed above the baseline (fraction)")
+    parser.add_argument("solver_args", nargs="*",
+                        help="options of microsat++ (after --)")
+    args = parser.parse_args()
+    sizes = {f: list(FAMILIES[f][0]) for f in FAMILIES}
+    for spec in args.sizes:
+        family, _, values = spec.partition("=")
+        sizes[family] = [int(v) for v in values.split(",")]
+    rows = []
+    with tempfile.TemporaryDirectory() as directory:
+        path = os.path.join(directory, "instance.cnf")
+        for family in args.families.split(","):
+            if family not in FAMILIES:
+                parser.error("unknown family %s" % family)
+            for n in sizes[family]:
+                # The deterministic families need one instance only
+                seeds = args.seeds if family in ("ksat", "color") else 1
+                for seed in range(1, seeds + 1):
+                    row = solve(args, family, n, seed, FAMILIES[family][1], path)
+                    rows.append(row)
+                    print("%-7s n=%-6d seed=%-3d %-15s %8.3fs %10d conflicts" %
+                          (family, n, seed, row["status"], row["seconds"],
+                           row["conflicts"]), flush=True)
+    if args.csv:
+        with open(args.csv, "w", newline="") as f:
+            writer = csv.DictWriter(f, fieldnames=list(rows[0]))
+            writer.writeheader()
+            writer.writerows(rows)
+    fits = summarize(rows)
+    report(fits)
+    if args.plot:
+        plot(fits, args.plot)
+    if args.baseline and not compare(fits, args.baseline, args.tolerance):
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
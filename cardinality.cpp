@@ -0,0 +1,144 @@
+//  ----------------------------------------------------------------------------
+//  Implementation file for the Cardinality class.               cardinality.cpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#include "cardinality.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <unordered_map>
+
+using namespace microsat;
+
+// -----------------------------------------------------------------------------
+// Creates an empty set of constraints
+Cardinality::Cardinality(int vars) : nVars(vars), occurs(2 * vars + 1) {
+    start.push_back(0);
+}
+
+// -----------------------------------------------------------------------------
+// Adds the constraint that at most k literals of *in are true
+void Cardinality::add(const int* in, int size, int k) {
+    int c = (int)bound.size();
+    for (int i = 0; i < size; i++) {
+        literals.push_back(in[i]);
+        occurs[in[i] + nVars].push_back(c);
+    }
+    start.push_back((int)literals.size());
+    bound.push_back(k);
+    count.push_back(0);
+}
+
+// -----------------------------------------------------------------------------
+// Adds the at-most-one constraints found in the binary clauses of formula
+void Cardinality::detect(const Formula& formula, std::vector<char>& covered) {
+    const int n = nVars;
+    // The binary clause (x | y) is an edge between -x and -y
+    auto key = [n](int a, int b) {
+        if (a > b)
+            std::swap(a, b);
+        return (std::uint64_t)(a + n) << 32 | (std::uint64_t)(b + n);
+    };
+    std::unordered_map<std::uint64_t, int> edges; // Edge to its clause
+    std::vector<std::vector<int>> neighbors(2 * n + 1);
+    const std::vector<int>& all = formula.getLiterals();
+    int index = 0;
+    for (std::size_t i = 0; i < all.size(); index++) {
+        std::size_t j = i;
+        while (all[j])
+            j++;
+        if (j - i == 2 && std::abs(all[i]) != std::abs(all[i + 1]) &&
+            edges.emplace(key(-all[i], -all[i + 1]), index).second) {
+            neighbors[-all[i] + n].push_back(-all[i + 1]);
+            neighbors[-all[i + 1] + n].push_back(-all[i]);
+        }
+        i = j + 1;
+    }
+    if (edges.empty())
+        return;
+    // Grow a clique greedily from each literal, most connected ones first
+    auto degree = [&neighbors, n](int l) {
+        return neighbors[l + n].size();
+    };
+    std::vector<int> order;
+    for (int l = -n; l <= n; l++)
+        if (l && degree(l) >= 2)
+            order.push_back(l);
+    std::stable_sort(order.begin(), order.end(),
+                     [&degree](int a, int b) { return degree(a) > degree(b); });
+    std::vector<int> clique, candidates;
+    for (int seed : order) {
+        candidates.clear();
+        for (int l : neighbors[seed + n])
+            if (!covered[edges[key(seed, l)]])
+                candidates.push_back(l);
+        if (candidates.size() < 2)
+            continue;
+        std::stable_sort(candidates.begin(), candidates.end(),
+                         [&degree](int a, int b) {
+                             return degree(a) > degree(b);
+                         });
+        clique.assign(1, seed);
+        for (int l : candidates) {
+            bool adjacent = true;
+            for (int member : clique)
+                adjacent = adjacent && edges.count(key(member, l));
+            if (adjacent)
+                clique.push_back(l);
+        }
+        // Smaller cliques save nothing over their binary clauses
+        if (clique.size() < 3)
+            continue;
+        for (std::size_t a = 0; a < clique.size(); a++)
+            for (std::size_t b = a + 1; b < clique.size(); b++)
+                covered[edges[key(clique[a], clique[b])]] = 1;
+        add(clique.data(), (int)clique.size(), 1);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Counts literal as true
+bool Cardinality::propagate(int literal, const int* false_,
+                            std::vector<int>& out) {
+    const std::vector<int>& list = occurs[literal + nVars];
+    // All counts first: undo() uncounts the literal everywhere
+    for (int c : list)
+        count[c]++;
+    for (int c : list) {
+        if (count[c] < bound[c])
+            continue;
+        // The true literals, the one counted now first
+        int snapshot = (int)snapshots.size();
+        snapshots.push_back(literal);
+        for (int i = start[c]; i < start[c + 1]; i++)
+            if (false_[-literals[i]] && literals[i] != literal &&
+                (int)snapshots.size() - snapshot <= bound[c])
+                snapshots.push_back(literals[i]);
+        if (count[c] > bound[c]) { // The k + 1 true literals are the conflict
+            conflict.clear();
+            for (int i = snapshot; i < (int)snapshots.size(); i++)
+                conflict.push_back(-snapshots[i]);
+            snapshots.resize(snapshot);
+            return true;
+        }
+        snapshots.resize(snapshot + bound[c]); // Exactly k true literals
+        snapshots.push_back(0);
+        // The count reached the bound: the unassigned literals are false
+        for (int i = start[c]; i < start[c + 1]; i++)
+            if (!false_[literals[i]] && !false_[-literals[i]]) {
+                out.push_back(literals[i]);
+                out.push_back(snapshot);
+            }
+    }
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+// Uncounts literal, which is no longer true
+void Cardinality::undo(int literal) {
+    for (int c : occurs[literal + nVars])
+        count[c]--;
+}
@@ -0,0 +1,67 @@
+//  ----------------------------------------------------------------------------
+//  Header file for the Cardinality class.                       cardinality.hpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#ifndef MICROSAT_CARDINALITY_HPP
+#define MICROSAT_CARDINALITY_HPP
+
+#include "formula.hpp"
+#include <memory>
+#include <vector>
+
+namespace microsat {
+
+// -----------------------------------------------------------------------------
+// Native at-most-k constraints. Each constraint counts its true literals:
+// the counts follow the stack of the solver, which reports every literal
+// that becomes true (propagate) and every one that is unassigned again
+// (undo). When the count reaches the bound the other literals are implied
+// false; their reason is a snapshot of the k true literals, turned into a
+// clause only if analyze() asks for it. A count above the bound is a
+// conflict, explained by the clause of k + 1 negated true literals.
+// At-most-one constraints are also found in the binary clauses: the clause
+// (-a | -b) is at-most-one of a and b, and cliques of such clauses become
+// a single constraint.
+class Cardinality {
+  private:
+    int nVars;                            // The number of variables
+    std::vector<int> literals;            // The literals of all constraints
+    std::vector<int> start;               // First literal of each constraint
+    std::vector<int> bound;               // At most bound[c] literals are true
+    std::vector<int> count;               // Number of true literals counted
+    std::vector<std::vector<int>> occurs; // Constraints of each literal
+    std::vector<int> snapshots;           // True literals of each reason
+    std::vector<int> conflict;            // The last falsified clause
+
+  public:
+    explicit Cardinality(int vars);
+
+    // Adds the constraint that at most k literals of *in of size size are
+    // true (k > 0 and k < size)
+    void add(const int* in, int size, int k);
+    // Adds the at-most-one constraints found in the binary clauses of
+    // formula, setting covered[c] for each clause c they replace
+    void detect(const Formula& formula, std::vector<char>& covered);
+
+    // Counts literal as true (false_[l] non-zero iff l is false); appends
+    // pairs of an implied false literal and its snapshot to out; returns
+    // true on conflict (see getConflict)
+    bool propagate(int literal, const int* false_, std::vector<int>& out);
+    // Uncounts literal, which is no longer true
+    void undo(int literal);
+    // The true literals of a snapshot, 0 terminated
+    const int* reason(int snapshot) const { return &snapshots[snapshot]; }
+    // Forgets the snapshots (no reason refers to them anymore)
+    void clearReasons() { snapshots.clear(); }
+
+    [[nodiscard]] const std::vector<int>& getConflict() const {
+        return conflict;
+    }
+    [[nodiscard]] int getConstraints() const { return (int)bound.size(); }
+};
+
+} // namespace microsat
+
+#endif // MICROSAT_CARDINALITY_HPP
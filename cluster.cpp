@@ -0,0 +1,571 @@
+//  ----------------------------------------------------------------------------
+//  Implementation file for the Coordinator and Worker classes.      cluster.cpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#include "cluster.hpp"
+
+#include "driver.hpp"
+#include "tools.hpp"
+#include "walker.hpp"
+#include "writer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <numeric>
+#include <poll.h>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace microsat;
+
+namespace {
+
+// Splits a TCP address "host:port" (the host may be empty: every interface
+// to listen on, this machine to connect to); returns false for the path of
+// a Unix domain socket
+bool tcp(const std::string& address, std::string& host, std::string& port) {
+    std::size_t colon = address.rfind(':');
+    if (colon == std::string::npos || colon + 1 == address.size() ||
+        address.find_first_not_of("0123456789", colon + 1) !=
+            std::string::npos)
+        return false;
+    host = address.substr(0, colon);
+    port = address.substr(colon + 1);
+    return true;
+}
+
+// Opens a socket on address, listening on it or connected to it; returns
+// -1 on failure (with errno set)
+int openSocket(const std::string& address, bool listening) {
+    std::string host, port;
+    if (!tcp(address, host, port)) {
+        sockaddr_un local{};
+        local.sun_family = AF_UNIX;
+        if (address.size() >= sizeof local.sun_path)
+            throw Fatal("socket path too long: %s", address.c_str());
+        std::strcpy(local.sun_path, address.c_str());
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0)
+            return -1;
+        if (listening)
+            unlink(address.c_str()); // Remove a stale socket of a past run
+        bool ready = listening
+                        ? bind(fd, (sockaddr*)&local, sizeof local) == 0 &&
+                              listen(fd, SOMAXCONN) == 0
+                        : connect(fd, (sockaddr*)&local, sizeof local) == 0;
+        if (!ready) {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = listening ? AI_PASSIVE : 0;
+    addrinfo* found = nullptr;
+    if (getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(),
+                    &hints, &found) != 0)
+        return -1;
+    int fd = -1;
+    for (addrinfo* a = found; a && fd < 0; a = a->ai_next) {
+        fd = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+        if (fd < 0)
+            continue;
+        int one = 1;
+        if (listening)
+            setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof one);
+        else // The messages are short lines: don't wait to fill packets
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof one);
+        bool ready = listening ? bind(fd, a->ai_addr, a->ai_addrlen) == 0 &&
+                                    listen(fd, SOMAXCONN) == 0
+                              : connect(fd, a->ai_addr, a->ai_addrlen) == 0;
+        if (!ready) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(found);
+    return fd;
+}
+
+// Parses the literals of p, of variables 1 to vars, up to the terminating
+// 0; returns false if the line is malformed
+bool parse(const char* p, int vars, std::vector<int>& literals) {
+    literals.clear();
+    for (;;) {
+        char* end = nullptr;
+        long literal = std::strtol(p, &end, 10);
+        if (end == p || std::labs(literal) > vars)
+            return false;
+        p = end;
+        if (!literal)
+            return true;
+        literals.push_back((int)literal);
+    }
+}
+
+// Appends the literals terminated by 0 to line
+void append(std::string& line, const int* literals, int size) {
+    for (int i = 0; i < size; i++) {
+        line += std::to_string(literals[i]);
+        line += ' ';
+    }
+    line += "0\n";
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// Splits the formula into the cubes of the variables of most occurrences:
+// every combination of their values
+void Coordinator::split() {
+    int vars = formula.getVars(), depth = std::min(cubes, vars);
+    std::vector<long> occurrences(vars + 1, 0);
+    for (int literal : formula.getLiterals())
+        occurrences[std::abs(literal)]++;
+    std::vector<int> order(vars);
+    std::iota(order.begin(), order.end(), 1);
+    std::partial_sort(order.begin(), order.begin() + depth, order.end(),
+                      [&](int a, int b) {
+                          return occurrences[a] > occurrences[b];
+                      });
+    jobs.assign(std::size_t(1) << depth, {});
+    for (std::size_t job = 0; job < jobs.size(); job++) {
+        for (int i = 0; i < depth; i++)
+            jobs[job].push_back(job >> i & 1 ? -order[i] : order[i]);
+        pending.push_back((int)job);
+    }
+    done.assign(jobs.size(), 0);
+    unsolved = (int)jobs.size();
+}
+
+// -----------------------------------------------------------------------------
+// Hands the next job out to peer: a cube not shown UNSAT yet, or the next
+// configuration of the portfolio (a lost one first)
+void Coordinator::assign(Peer& peer) {
+    if (cubes)
+        while (!pending.empty() && done[pending.front()])
+            pending.pop_front();
+    int job;
+    if (!pending.empty()) {
+        job = pending.front();
+        pending.pop_front();
+    } else if (!cubes) {
+        job = configs++;
+    } else {
+        return; // Every cube is handed out
+    }
+    peer.job = job;
+    peer.out += "j " + std::to_string(job) + " " +
+                std::to_string(cubes ? peer.config : job) + " ";
+    if (cubes)
+        append(peer.out, jobs[job].data(), (int)jobs[job].size());
+    else
+        peer.out += "0\n";
+}
+
+// -----------------------------------------------------------------------------
+// Reads what peer sent and handles its complete lines
+int Coordinator::receive(Peer& peer, std::vector<int>& model) {
+    char chunk[1 << 16];
+    for (;;) {
+        ssize_t n = read(peer.fd, chunk, sizeof chunk);
+        if (n > 0) {
+            peer.in.append(chunk, n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+            peer.lost = true; // The worker went away
+        break;
+    }
+    int result = UNKNOWN;
+    std::size_t start = 0, end;
+    while (result == UNKNOWN &&
+           (end = peer.in.find('\n', start)) != std::string::npos) {
+        result = handle(peer, peer.in.substr(start, end - start), model);
+        start = end + 1;
+    }
+    peer.in.erase(0, start);
+    return result;
+}
+
+// -----------------------------------------------------------------------------
+// Handles a line of peer: forwards its lemmas, and collects its results
+int Coordinator::handle(Peer& peer, const std::string& line,
+                        std::vector<int>& model) {
+    int vars = formula.getVars();
+    std::vector<int> literals;
+    if (line[0] == 'l' && parse(line.c_str() + 1, vars, literals)) {
+        // Forward the lemmas not shared yet (to the workers to come too)
+        std::sort(literals.begin(), literals.end());
+        if (!literals.empty() && shared.insert(literals).second) {
+            lemmas += line + "\n";
+            for (Peer& other : peers)
+                if (&other != &peer)
+                    other.out += line + "\n";
+        }
+    } else if (line[0] == 'v' && parse(line.c_str() + 1, vars, literals)) {
+        peer.model = literals;
+    } else if (line[0] == 's') {
+        int job, code;
+        if (sscanf(line.c_str(), "s %i %i", &job, &code) != 2 ||
+            job != peer.job)
+            return UNKNOWN;
+        peer.job = -1;
+        if (code == 10) { // Check the model before reporting it
+            model.assign(vars + 1, 0);
+            for (int literal : peer.model)
+                model[std::abs(literal)] = (literal > 0);
+            int clause = formula.check(model.data());
+            if (clause >= 0)
+                throw Fatal("c model check failed: clause %i is falsified",
+                            clause + 1);
+            return SAT;
+        }
+        if (!cubes) // The whole formula
+            return UNSAT;
+        if (!done[job]) {
+            done[job] = 1;
+            if (--unsolved == 0)
+                return UNSAT;
+        }
+        assign(peer);
+    }
+    return UNKNOWN;
+}
+
+// -----------------------------------------------------------------------------
+// Sends what can be sent of peer.out without blocking
+void Coordinator::send(Peer& peer) {
+    while (peer.sent < peer.out.size()) {
+        ssize_t n = write(peer.fd, peer.out.data() + peer.sent,
+                          peer.out.size() - peer.sent);
+        if (n > 0) {
+            peer.sent += n;
+            continue;
+        }
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+            peer.lost = true;
+        break;
+    }
+    if (peer.sent == peer.out.size()) {
+        peer.out.clear();
+        peer.sent = 0;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Solves the file with the workers connecting to address: waits for their
+// connections, lines and room to send on every socket at once
+int Coordinator::run(const std::string& filename, const std::string& address,
+                     bool stats) {
+    std::unique_ptr<Solver> solver = nullptr;
+    int result = driver::parse(filename, solver, formula, options);
+    solver = nullptr; // The workers solve
+    if (!formula.getCardinalities().empty())
+        throw Fatal("distributed solving does not support cardinality "
+                    "constraints");
+    std::vector<int> model;
+    if (result != UNSAT) {
+        std::ostringstream header;
+        header << "p cnf " << formula.getVars() << " "
+               << formula.getClauses() << "\n";
+        text = header.str();
+        const std::vector<int>& literals = formula.getLiterals();
+        for (std::size_t i = 0, start = 0; i < literals.size(); i++)
+            if (!literals[i]) {
+                append(text, &literals[start], (int)(i - start));
+                start = i + 1;
+            }
+        if (cubes)
+            split();
+        int listener = openSocket(address, true);
+        if (listener < 0)
+            throw Fatal("can't listen on %s: %s", address.c_str(),
+                        strerror(errno));
+        fcntl(listener, F_SETFL, O_NONBLOCK);
+        signal(SIGPIPE, SIG_IGN); // A worker may go away during a line
+        std::vector<pollfd> fds;
+        result = UNKNOWN;
+        while (result == UNKNOWN) {
+            fds.assign(1, {listener, POLLIN, 0});
+            for (Peer& peer : peers)
+                fds.push_back({peer.fd,
+                               short(peer.out.empty() ? POLLIN
+                                                      : POLLIN | POLLOUT),
+                               0});
+            if (poll(fds.data(), fds.size(), -1) < 0) {
+                if (errno == EINTR)
+                    continue;
+                throw Fatal("poll failed: %s", strerror(errno));
+            }
+            for (std::size_t i = 0; i < peers.size() && result == UNKNOWN;
+                 i++) {
+                short events = fds[i + 1].revents;
+                if (events & (POLLIN | POLLHUP | POLLERR))
+                    result = receive(peers[i], model);
+                if (events & POLLOUT)
+                    send(peers[i]);
+            }
+            // Hand the jobs of the workers gone out again
+            for (auto peer = peers.begin(); peer != peers.end();)
+                if (peer->lost) {
+                    if (peer->job >= 0) {
+                        pending.push_front(peer->job);
+                        lost++;
+                    }
+                    close(peer->fd);
+                    peer = peers.erase(peer);
+                } else {
+                    ++peer;
+                }
+            if (result != UNKNOWN)
+                break;
+            for (Peer& peer : peers)
+                if (peer.job < 0)
+                    assign(peer);
+            // A new worker gets the formula, the lemmas so far and a job
+            if (fds[0].revents & POLLIN) {
+                int fd = accept(listener, nullptr, nullptr);
+                if (fd >= 0) {
+                    int one = 1;
+                    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof one);
+                    fcntl(fd, F_SETFL, O_NONBLOCK);
+                    peers.push_back(Peer{fd, connected++});
+                    peers.back().out = text + lemmas;
+                    assign(peers.back());
+                }
+            }
+        }
+        // Stop the workers: those busy sending lose the connection instead
+        for (Peer& peer : peers) {
+            peer.out += "q\n";
+            send(peer);
+            close(peer.fd);
+        }
+        peers.clear();
+        close(listener);
+        std::string host, port;
+        if (!tcp(address, host, port))
+            unlink(address.c_str());
+    }
+    Writer out;
+    out.status(result);
+    if (result == SAT)
+        out.model(model.data(), formula.getVars());
+    if (stats) {
+        std::ostringstream line;
+        line << "statistics of " << filename << ":";
+        out.comment(line.str().c_str());
+        line.str("");
+        line << "[ workers: " << connected
+             << ", jobs: " << (cubes ? (int)jobs.size() : configs)
+             << ", lost: " << lost << ", shared: " << shared.size() << " ]";
+        out.comment(line.str().c_str());
+    }
+    out.flush();
+    return Writer::exitCode(result);
+}
+
+// -----------------------------------------------------------------------------
+// The options of configuration config: the restart policies in turn, then
+// with the other rephasing, then backtracking chronologically, then with
+// the other target phases. Configuration 0 is the options of the worker.
+Options Worker::configuration(int config) const {
+    Options configured = options;
+    configured.restarts = Restarts(((int)options.restarts + config) % 5);
+    if (config / 5 % 2)
+        configured.rephase = !options.rephase;
+    if (config / 10 % 2)
+        configured.chrono = options.chrono ? 0 : 100;
+    configured.target = (options.target + config / 20) % 3;
+    return configured;
+}
+
+// -----------------------------------------------------------------------------
+// Creates the solver for configuration config from the formula; its
+// checkpoint hook is where the search sends the lemmas it learned and takes
+// in those of the others
+void Worker::build(int config) {
+    Options configured = configuration(config);
+    solver = std::make_unique<Solver>(formula.getVars(), formula.getClauses(),
+                                      configured);
+    this->config = config;
+    solver->walker = Walker::provider(formula);
+    solver->learned = [this](const int* lemma, int size) {
+        if (size <= share) {
+            exports += "l ";
+            append(exports, lemma, size);
+        }
+    };
+    solver->checkpoint = [this]() {
+        send(exports);
+        exports.clear();
+        receive(false);
+        // Stop the search to add the lemmas received
+        return !stopped && added == imported.size();
+    };
+    std::vector<int> clause;
+    for (int literal : formula.getLiterals())
+        if (literal) {
+            clause.push_back(literal);
+        } else {
+            solver->addInput(clause.data(), (int)clause.size());
+            clause.clear();
+        }
+    if (configured.xors)
+        if (auto xors = Gauss::create(formula))
+            solver->attach(std::move(xors));
+    added = 0;
+}
+
+// -----------------------------------------------------------------------------
+// Adds the lemmas imported since the last call as input clauses
+int Worker::import() {
+    int result = SAT;
+    std::vector<int> clause;
+    for (; added < imported.size(); added++)
+        if (imported[added]) {
+            clause.push_back(imported[added]);
+        } else {
+            if (solver->addInput(clause.data(), (int)clause.size()) == UNSAT)
+                result = UNSAT;
+            clause.clear();
+        }
+    return result;
+}
+
+// -----------------------------------------------------------------------------
+// Solves a job line, taking in lemmas during the search, and sends the
+// result (unless the coordinator stopped meanwhile)
+void Worker::solve(const std::string& line) {
+    int job, config, offset = 0;
+    std::vector<int> literals;
+    if (sscanf(line.c_str(), "j %i %i%n", &job, &config, &offset) != 2 ||
+        !parse(line.c_str() + offset, formula.getVars(), literals))
+        throw Fatal("bad job: %s", line.c_str());
+    if (!solver || config != this->config)
+        build(config);
+    solver->assume(literals.data(), (int)literals.size());
+    int result;
+    do
+        result = import() == UNSAT ? UNSAT : solver->solve();
+    while (result == UNKNOWN && !stopped);
+    if (stopped)
+        return;
+    std::string answer;
+    answer.swap(exports);
+    if (result == SAT) {
+        const int* model = solver->getModel();
+        answer += "v ";
+        for (int var = 1; var <= solver->getVars(); var++)
+            answer += std::to_string(model[var] ? var : -var) + " ";
+        answer += "0\n";
+    }
+    answer += "s " + std::to_string(job) + (result == SAT ? " 10\n" : " 20\n");
+    send(answer);
+}
+
+// -----------------------------------------------------------------------------
+// Handles the lemmas and stop of the lines received
+std::string Worker::receive(bool wait) {
+    std::vector<int> literals;
+    for (;;) {
+        std::size_t end;
+        while ((end = in.find('\n', consumed)) != std::string::npos) {
+            std::string line = in.substr(consumed, end - consumed);
+            consumed = end + 1;
+            if (line.empty())
+                continue;
+            if (line[0] == 'q') {
+                stopped = true;
+                return "";
+            }
+            if (line[0] != 'l')
+                return line;
+            if (parse(line.c_str() + 1, formula.getVars(), literals)) {
+                imported.insert(imported.end(), literals.begin(),
+                                literals.end());
+                imported.push_back(0);
+            }
+        }
+        if (stopped)
+            return "";
+        pollfd fds = {fd, POLLIN, 0};
+        if (!wait && poll(&fds, 1, 0) <= 0)
+            return "";
+        in.erase(0, consumed);
+        consumed = 0;
+        char chunk[1 << 16];
+        ssize_t n = read(fd, chunk, sizeof chunk);
+        if (n > 0) {
+            in.append(chunk, n);
+        } else if (n == 0 || errno != EINTR) { // The coordinator went away
+            stopped = true;
+            return "";
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Sends text, blocking
+void Worker::send(const std::string& text) {
+    for (std::size_t sent = 0; sent < text.size() && !stopped;) {
+        ssize_t n = write(fd, text.data() + sent, text.size() - sent);
+        if (n > 0)
+            sent += n;
+        else if (n == 0 || errno != EINTR)
+            stopped = true;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Connects to the coordinator (which may not listen yet: retries for ten
+// seconds) and handles its lines until it stops or goes away
+int Worker::run(const std::string& address) {
+    signal(SIGPIPE, SIG_IGN); // The coordinator may go away during a line
+    for (int attempt = 0; (fd = openSocket(address, false)) < 0; attempt++) {
+        if (attempt == 100)
+            throw Fatal("can't connect to %s: %s", address.c_str(),
+                        strerror(errno));
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    std::vector<int> literals;
+    for (;;) {
+        std::string line = receive(true);
+        if (stopped)
+            break;
+        if (line[0] == 'p') { // A new formula
+            int vars, clauses;
+            if (sscanf(line.c_str(), "p cnf %i %i", &vars, &clauses) != 2 ||
+                vars < 1)
+                throw Fatal("bad problem line: %s", line.c_str());
+            formula = Formula(vars);
+            solver = nullptr;
+            imported.clear();
+            added = 0;
+        } else if (line[0] == 'j') {
+            solve(line);
+        } else if (parse(line.c_str(), formula.getVars(), literals)) {
+            formula.addClause(literals.data(), (int)literals.size());
+        } else {
+            throw Fatal("bad line from the coordinator: %s", line.c_str());
+        }
+    }
+    close(fd);
+    return 0;
+}
@@ -0,0 +1,138 @@
+//  ----------------------------------------------------------------------------
+//  Header file for the Coordinator and Worker classes.              cluster.hpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#ifndef MICROSAT_CLUSTER_HPP
+#define MICROSAT_CLUSTER_HPP
+
+#include "formula.hpp"
+#include "solver.hpp"
+#include <deque>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace microsat {
+
+// -----------------------------------------------------------------------------
+// Distributed solving: a coordinator hands out jobs to worker processes, on
+// this machine or others, connected over TCP ("host:port") or a Unix domain
+// socket (a path). A job is either a cube of the formula, solved under its
+// literals as assumptions, or (without cubes) the whole formula solved with
+// one configuration of a portfolio. Every worker that connects is sent the
+// formula (a "p cnf" line and its clauses), then speaks a line-based
+// protocol:
+//     j <job> <config> <lit> ... 0  solve job with the configuration config
+//                                   under the literals (coordinator)
+//     l <lit> ... 0                 a short lemma learned by a worker, sent
+//                                   to the coordinator, which forwards it to
+//                                   the other workers
+//     v <lit> ... 0                 the model of the next result (worker)
+//     s <job> <10|20>               job is SAT (10) or UNSAT (20) (worker)
+//     q                             stop (coordinator)
+// The lemmas are consequences of the formula alone (the assumptions are
+// decisions), so a worker adds them as input clauses. The job of a worker
+// that goes away is handed out again.
+class Coordinator {
+  private:
+    // A connected worker
+    struct Peer {
+        int fd;
+        int config;             // Its configuration (for cubes)
+        int job = -1;           // The job it solves (-1: none)
+        std::string in;         // Received, not handled yet
+        std::string out;        // To send
+        std::size_t sent = 0;   // Length of out sent already
+        std::vector<int> model; // Sent before its result
+        bool lost = false;      // The connection failed
+    };
+
+    const Options options; // Options of the parsing
+    const int cubes;       // Variables split on (0: portfolio)
+    Formula formula;
+    std::string text;                   // The formula, sent to every worker
+    std::string lemmas;                 // The lemmas shared so far, likewise
+    std::set<std::vector<int>> shared;  // Those lemmas (sorted)
+    std::vector<std::vector<int>> jobs; // The literals of every cube
+    std::vector<char> done;             // Whether each cube is UNSAT
+    int unsolved = 0;                   // Cubes not shown UNSAT yet
+    std::deque<int> pending; // Jobs to hand out again (lost by a worker)
+    int configs = 0;         // Portfolio jobs handed out so far
+    std::vector<Peer> peers;
+    int connected = 0; // Workers connected so far
+    int lost = 0;      // Jobs lost by workers
+
+    // Splits the formula into the 2^cubes cubes of its most frequent
+    // variables
+    void split();
+    // Hands the next job, if any, out to peer
+    void assign(Peer& peer);
+    // Reads what peer sent and handles its complete lines; returns SAT or
+    // UNSAT once the formula is solved, otherwise UNKNOWN
+    int receive(Peer& peer, std::vector<int>& model);
+    // Handles a line of peer (see receive())
+    int handle(Peer& peer, const std::string& line, std::vector<int>& model);
+    // Sends what can be sent of peer.out without blocking (marks it lost if
+    // the connection failed)
+    static void send(Peer& peer);
+
+  public:
+    // Splits on cubes variables (0: runs a portfolio instead)
+    explicit Coordinator(int cubes = 0, Options options = {})
+        : options(options), cubes(cubes) {}
+
+    // Solves the DIMACS file with the workers that connect to address;
+    // returns the exit code of the competition format
+    int run(const std::string& filename, const std::string& address,
+            bool stats = false);
+};
+
+// -----------------------------------------------------------------------------
+// A worker of a Coordinator (see there): solves the jobs it is handed out
+// with one solver, kept from a job to the next while its configuration
+// stays the same, and sends the lemmas of at most share literals it learns
+class Worker {
+  private:
+    const Options options; // Options of the solver (before the configuration)
+    const int share;       // The longest lemmas sent
+    int fd = -1;
+    std::string in;                // Received
+    std::size_t consumed = 0;      // Length of in handled already
+    std::string exports;           // Lemmas learned, not sent yet
+    Formula formula;
+    std::vector<int> imported;     // Lemmas of others, each terminated by 0
+    std::size_t added = 0;         // Length of imported added to the solver
+    std::unique_ptr<Solver> solver;
+    int config = -1;               // The configuration of the solver
+    bool stopped = false;          // The coordinator stopped or went away
+
+    // The options of configuration config of the portfolio
+    Options configuration(int config) const;
+    // Creates the solver for configuration config (with the lemmas)
+    void build(int config);
+    // Adds the lemmas imported since the last call; returns UNSAT if the
+    // formula became unsatisfiable
+    int import();
+    // Solves a job line
+    void solve(const std::string& line);
+    // Handles the lemmas and stop of the lines received, waiting for more
+    // if wait; returns the first line of another kind (empty if none)
+    std::string receive(bool wait);
+    // Sends text, blocking; stops if the coordinator went away
+    void send(const std::string& text);
+
+  public:
+    explicit Worker(int share = 2, Options options = {})
+        : options(options), share(share) {}
+
+    // Connects to the coordinator at address and solves its jobs until it
+    // stops; returns 0
+    int run(const std::string& address);
+};
+
+} // namespace microsat
+
+#endif // MICROSAT_CLUSTER_HPP
@@ -6,40 +6,170 @@
 
 #include "driver.hpp"
 
+#include "parser.hpp"
+#include "snapshot.hpp"
+#include "symmetry.hpp"
 #include "tools.hpp"
+#include "tractable.hpp"
+#include "walker.hpp"
+#include "writer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <sys/resource.h>
 #include <utility>
 
 using namespace microsat;
 
+namespace {
+
+// The checkpoint asked for by a signal: 1 (SIGUSR1) checkpoint, 2 (SIGTERM,
+// SIGINT) checkpoint and stop
+volatile std::sig_atomic_t requested = 0;
+
+void request(int signal) {
+    if (signal != SIGUSR1)
+        requested = 2;
+    else if (!requested)
+        requested = 1;
+}
+
+// The trace asked for by SIGUSR2
+volatile std::sig_atomic_t traced = 0;
+
+void dumpTrace(int) { traced = 1; }
+
+} // namespace
+
 // -----------------------------------------------------------------------------
-//
-driver::driver(std::string file, bool stats)
-    : filename(std::move(file)), stats(stats) {
-    if (parse() == UNSAT) {
-        std::cout << "unsat";
+// Picks the solver: the strategies switched off aren't compiled into it
+driver::driver(std::string file, bool stats, Options options)
+    : filename(std::move(file)), stats(stats), options(options) {
+    if (!options.proof.empty()) {
+        // The clauses of XORs, constraints and symmetries aren't DRAT steps
+        this->options.xors = false;
+        this->options.cardinality = false;
+        this->options.symmetry = false;
+        if (options.minimize)
+            run<ProofSolver>();
+        else
+            run<PlainProofSolver>();
+    } else if (!options.minimize) {
+        run<PlainSolver>();
+    } else {
+        run<Solver>();
     }
-    // Solve without limit (number of conflicts)
-    else if (solver->solve() == UNSAT) {
-        std::cout << "unsat";
+}
+
+// -----------------------------------------------------------------------------
+// Solves the file with the solver S
+template <class S> void driver::run() {
+    std::unique_ptr<S> solver = nullptr;
+    int result = options.load_snapshot.empty()
+                     ? parse(filename, solver, formula, options)
+                     : load(options.load_snapshot, solver, formula, options);
+    if (!options.dump_snapshot.empty()) {
+        if (result == UNSAT) // Not necessarily found by the solver
+            solver->inconsistent = true;
+        solver->dump(options.dump_snapshot, formula);
     }
-    // And print whether the formula has a solution
-    else {
-        std::cout << "sat ";
-        for (int i = 1; i <= solver->nVars; i++) {
-            if (solver->model[i])
-                std::cout << i << " ";
-            else
-                std::cout << "-" << i << " ";
+    if (!options.checkpoint.empty() && result != UNSAT)
+        checkpoints(*solver);
+    if (!options.trace.empty())
+        traces(*solver);
+    if (!options.proof.empty() && !formula.getCardinalities().empty())
+        throw Fatal("DRAT proofs don't support cardinality constraints");
+    Writer out;
+    long long flips = -1;  // Flips of the local search, if it ran
+    long long models = -1; // Models enumerated, if enumerating
+    Tractable::Fragment fragment = Tractable::Fragment::general;
+    if (result != UNSAT && options.local_search) {
+        if (!formula.getCardinalities().empty())
+            throw Fatal("local search does not support cardinality "
+                        "constraints");
+        // Local search from the top-level phases finds a model or gives up
+        Walker walker(formula);
+        walker.init(solver->model);
+        result = walker.walk(options.flips) ? UNKNOWN : SAT;
+        walker.getBest(solver->model);
+        flips = walker.getFlips();
+    } else if (result != UNSAT && options.models) {
+        // The models are written as they are found
+        models = enumerate(*solver, out);
+        result = models ? SAT : UNSAT;
+    } else if (result != UNSAT) {
+        // The fragments decided in linear time need no search
+        int decided = UNKNOWN;
+        if (fastPath(formula, options)) {
+            Tractable tractable(formula);
+            fragment = tractable.classify();
+            if (fragment != Tractable::Fragment::general)
+                decided = tractable.solve(fragment, solver->model);
+            if (decided == UNKNOWN) // Searched after all
+                fragment = Tractable::Fragment::general;
         }
-        std::cout << "\n";
+        // Solve without limit (number of conflicts)
+        result = decided != UNKNOWN ? decided : solver->solve();
     }
+    if (models < 0) {
+        // Check the model against the input before reporting it
+        if (result == SAT) {
+            int clause = formula.check(solver->model);
+            if (clause >= 0)
+                throw Fatal("c model check failed: clause %i is falsified",
+                            clause + 1);
+        }
+        // And print whether the formula has a solution
+        out.status(result);
+        if (result == SAT)
+            out.model(solver->model, solver->nVars);
+    } else if (!models) {
+        out.status(UNSAT);
+    }
+    exit_code = Writer::exitCode(result);
     // Print the statistics
-    if (stats)
-        std::cout << "statistics of " << filename << ":\n"
-                  << "[ mem_used: " << solver->mem_used()
-                  << ", conflicts: " << solver->nConflicts
-                  << ", lemmas: " << solver->nLemmas
-                  << ", max_lemmas: " << solver->maxLemmas << " ]\n";
+    if (stats) {
+        std::ostringstream line;
+        line << "statistics of "
+             << (filename.empty() ? options.load_snapshot : filename) << ":";
+        out.comment(line.str().c_str());
+        line.str("");
+        line << "[ mem_used: " << solver->mem_used()
+             << ", conflicts: " << solver->nConflicts
+             << ", lemmas: " << solver->nLemmas
+             << ", max_lemmas: " << solver->maxLemmas;
+        if (flips >= 0)
+            line << ", flips: " << flips;
+        if (models >= 0)
+            line << ", models: " << models;
+        if (fragment != Tractable::Fragment::general)
+            line << ", fragment: " << Tractable::name(fragment);
+        if (solver->cards)
+            line << ", cardinality: " << solver->cards->getConstraints();
+        if (solver->gauss)
+            line << ", xors: " << solver->gauss->getXors()
+                 << ", rows: " << solver->gauss->getRows();
+        line << " ]";
+        out.comment(line.str().c_str());
+        // The arena by category, and the peak resident set of the process
+        auto usage = solver->usage();
+        rusage self{};
+        getrusage(RUSAGE_SELF, &self);
+        out.comment("memory in bytes:");
+        line.str("");
+        line << "[ variables: " << sizeof(int) * usage.variables
+             << ", input: " << sizeof(int) * usage.input
+             << ", lemmas: " << sizeof(int) * usage.lemmas
+             << ", watches: " << sizeof(int) * usage.watches
+             << ", waste: " << sizeof(int) * usage.waste
+             << ", garbage: " << sizeof(int) * usage.garbage
+             << ", high_water: " << sizeof(int) * usage.high
+             << ", peak_rss: " << 1024L * self.ru_maxrss << " ]";
+        out.comment(line.str().c_str());
+    }
+    out.flush();
+    if (solver->trace && !solver->trace->write(options.trace))
+        throw Fatal("can't write the trace to %s", options.trace.c_str());
 
     P("c--------------------------------------------------------------\n"
       << "c statistics of " << filename << ":\n"
@@ -49,62 +179,280 @@ driver::driver(std::string file, bool stats)
 }
 
 // -----------------------------------------------------------------------------
-// Parse the DIMACS file
-int driver::parse() {
-    std::ifstream in(filename);
-    if (in) { // checks if the file is open
-        string line;
-        while (!in.eof()) {
-            getline(in, line);
-            if (line.length() == 0 || line[0] == 'c') {
+// Enumerates the models of the formula (at most options.models if positive)
+// projected on its shown variables, writing each one checked to out after
+// the status line; returns their number
+template <class S> long long driver::enumerate(S& solver, Writer& out) {
+    const std::vector<int>& shown = formula.getShown();
+    long long models = 0;
+    solver.enumerate(shown, [&](const int* model) {
+        int clause = formula.check(model);
+        if (clause >= 0)
+            throw Fatal("c model check failed: clause %i is falsified",
+                        clause + 1);
+        if (!models)
+            out.status(SAT);
+        if (shown.empty())
+            out.model(model, solver.nVars);
+        else
+            out.model(model, shown);
+        return ++models != options.models;
+    });
+    return models;
+}
+
+// -----------------------------------------------------------------------------
+// Checkpoints the search of solver every checkpoint_interval seconds, and
+// when a signal asks for it
+template <class S> void driver::checkpoints(S& solver) {
+    using clock = std::chrono::steady_clock;
+    auto interval = std::chrono::duration_cast<clock::duration>(
+        std::chrono::duration<double>(options.checkpoint_interval));
+    auto due = clock::now() + interval;
+    std::signal(SIGUSR1, request);
+    std::signal(SIGTERM, request);
+    std::signal(SIGINT, request);
+    solver.checkpoint = [this, &solver, interval, due]() mutable {
+        int signalled = requested;
+        if (!signalled && clock::now() < due)
+            return true;
+        requested = 0;
+        solver.dump(options.checkpoint, formula);
+        if (options.verbose)
+            printf("c checkpoint after %i conflicts\n", solver.nConflicts);
+        due = clock::now() + interval;
+        return signalled < 2;
+    };
+}
+
+// -----------------------------------------------------------------------------
+// Records the events of the search of solver, written when SIGUSR2 asks for
+// them (at the next checkpoint hook, before the one of checkpoints(), if
+// any) and at the end
+template <class S> void driver::traces(S& solver) {
+    solver.trace = std::make_unique<Trace>((std::size_t)options.trace_events);
+    std::signal(SIGUSR2, dumpTrace);
+    auto next = std::move(solver.checkpoint);
+    solver.checkpoint = [this, &solver, next]() {
+        if (traced) {
+            traced = 0;
+            if (!solver.trace->write(options.trace))
+                printf("c can't write the trace to %s\n",
+                       options.trace.c_str());
+            else if (options.verbose)
+                printf("c trace after %i conflicts\n", solver.nConflicts);
+        }
+        return !next || next();
+    };
+}
+
+// -----------------------------------------------------------------------------
+// Adds the KNF constraint that at least k of the literals are true
+template <class S>
+int driver::addAtLeast(S& s, Formula& formula,
+                       std::unique_ptr<Cardinality>& cards, int k,
+                       std::vector<int>& literals) {
+    // That is: at most size - k of the negated literals
+    int size = (int)literals.size(), most = size - k;
+    if (k <= 0)
+        return SAT;
+    if (most < 0)
+        return UNSAT;
+    if (most == 0) { // Every literal is a unit
+        for (int i = 0; i < size; i++) {
+            int unit = literals[i];
+            formula.addClause(&unit, 1);
+            if (s.addInput(&unit, 1) == UNSAT)
+                return UNSAT;
+        }
+    } else if (k == 1) { // A clause
+        formula.addClause(literals.data(), size);
+        return s.addInput(literals.data(), size);
+    } else {
+        for (int& literal : literals)
+            literal = -literal;
+        formula.addCardinality(literals.data(), size, most);
+        if (!cards)
+            cards = std::make_unique<Cardinality>(s.nVars);
+        cards->add(literals.data(), size, most);
+    }
+    return SAT;
+}
+
+// -----------------------------------------------------------------------------
+// Parse the DIMACS file; an existing solver is reset and reused. The chunks
+// of the file are parsed on other threads while this one adds the clauses
+// and propagates the units found so far.
+template <class S>
+int driver::parse(const std::string& filename, std::unique_ptr<S>& solver,
+                  Formula& formula, const Options& options) {
+    Parser parser(filename, options.threads);
+    int nVars = parser.getVars(), nClauses = parser.getClauses();
+    P("c p cnf " << nVars << " " << nClauses);
+    // late binding of the solver
+    if (solver)
+        solver->reset(nVars, nClauses);
+    else
+        solver = std::make_unique<S>(nVars, nClauses, options);
+    formula = Formula(nVars);
+    // Local search phases for rephasing
+    solver->walker = Walker::provider(formula);
+    std::unique_ptr<Cardinality> cards = nullptr; // at-most-k constraints
+    auto& s = *solver;
+    std::vector<int> clause; // The literals of the clause (or constraint)
+    int k = 0;               // The bound of a KNF constraint ("k" line)
+    bool constraint = false; // The literals are those of a "k" line
+    bool bound = false;      // The next token is the bound of a "k" line
+    bool shown = false;      // The tokens are those of a "c p show" line
+    bool unsat = false;
+    while (const std::vector<int>* literals = parser.next()) {
+        for (int literal : *literals) {
+            if (shown) { // The projection, up to 0
+                if (literal)
+                    formula.show(literal);
+                else
+                    shown = false;
                 continue;
-            } else if (line[0] == 'p') {
-                std::size_t pos = line.find("cnf", 0);
-                if (pos != std::string::npos) {
-                    std::string str = line.substr(pos + 4, line.length());
-                    int nVars, nClauses;
-                    std::istringstream ss(str);
-                    if (!(ss >> nVars >> nClauses)) // extract vars and clausesS
-                        throw Fatal("can't extract nVars and nClauses!");
-                    P("c p cnf " << nVars << " " << nClauses);
-                    // late binding of the solver
-                    solver = std::make_unique<Solver>(nVars, nClauses);
-                }
-            } else {
-                std::istringstream ss(line);
-                auto& s = *solver;
-                int size = 0, literal = 0;
-                P("c ");
-                do {                     // for each clause in the file
-                    if (ss >> literal) { // !in.fail()
-                        if (literal == 0)
-                            break;
-                        s.buffer[size++] = literal;
-                        P(literal << " ");
-                    }
-                } while (ss.good());
-                P("\n");
-                if (!ss.eof())
-                    throw Fatal(
-                        "I/O error or bad data during clause extraction");
+            }
+            if (bound) {
+                k = literal;
+                bound = false;
+                continue;
+            }
+            if (literal == Parser::knf) {
+                constraint = bound = true;
+                continue;
+            }
+            if (literal == Parser::show) {
+                shown = true;
+                continue;
+            }
+            if (literal) {
+                clause.push_back(literal);
+                P(literal << " ");
+                continue;
+            }
+            P("\n");
+            if (!constraint) {
                 // reached the end of the clause; add the clause to database
-                int* clause = s.addClause(s.buffer, size, 1);
+                int size = (int)clause.size();
+                formula.addClause(clause.data(), size);
                 // Check for empty clause or conflicting unit
-                // If either is found return UNSAT
-                if (!size || ((size == 1) && s.false_[clause[0]]))
-                    return UNSAT; //
-                // Check for a new unit
-                if ((size == 1) && !s.false_[-clause[0]]) {
-                    s.assign(clause, 1);
-                } // Directly assign new units (forced = 1)
-            }     // Reset buffer
+                unsat = unsat || s.addInput(clause.data(), size) == UNSAT;
+            } else if (!unsat) { // KNF: at least k of the literals
+                unsat = addAtLeast(s, formula, cards, k, clause) == UNSAT;
+            }
+            clause.clear();
+            constraint = false;
         }
-
-    } // End While
-    in.close();
+        // Propagate the units while the next chunks are parsed
+        if (unsat || s.simplify() == UNSAT)
+            return UNSAT;
+    }
+    if (constraint)
+        throw Fatal("bad cardinality constraint in %s", filename.c_str());
+    if (!clause.empty()) { // The last clause lacks its 0
+        formula.addClause(clause.data(), (int)clause.size());
+        if (s.addInput(clause.data(), (int)clause.size()) == UNSAT)
+            return UNSAT;
+    }
+    // Replace the at-most-one cliques of binary clauses by constraints:
+    // the solver starts over without the clauses they cover
+    if (options.cardinality) {
+        std::vector<char> covered(formula.getClauses(), 0);
+        if (!cards)
+            cards = std::make_unique<Cardinality>(formula.getVars());
+        cards->detect(formula, covered);
+        if (std::find(covered.begin(), covered.end(), 1) != covered.end()) {
+            auto& s = *solver;
+            s.reset(formula.getVars(), formula.getClauses());
+            const std::vector<int>& literals = formula.getLiterals();
+            int index = 0, size = 0;
+            for (int literal : literals)
+                if (literal) {
+                    s.buffer[size++] = literal;
+                } else {
+                    if (!covered[index++] &&
+                        s.addInput(s.buffer, size) == UNSAT)
+                        return UNSAT;
+                    size = 0;
+                }
+        }
+    }
+    if (cards && cards->getConstraints())
+        solver->attach(std::move(cards));
+    // Break the symmetries of the input (the clauses are not input clauses
+    // and aren't added to formula)
+    if (options.symmetry) {
+        std::vector<int> clauses;
+        Symmetry(formula, options.symmetry_time).breaking(clauses);
+        auto& s = *solver;
+        int size = 0;
+        for (int literal : clauses)
+            if (literal) {
+                s.buffer[size++] = literal;
+            } else {
+                if (s.addInput(s.buffer, size) == UNSAT)
+                    return UNSAT;
+                size = 0;
+            }
+    }
+    // Hand the XORs of the clauses to Gaussian elimination
+    if (options.xors)
+        if (auto xors = Gauss::create(formula))
+            return solver->attach(std::move(xors));
     return SAT; // Return that no conflict was observed
 }
 
+// -----------------------------------------------------------------------------
+// Loads a snapshot: the arena is mapped from the file and only the XORs and
+// the KNF constraints are built again, from the formula
+template <class S>
+int driver::load(const std::string& filename, std::unique_ptr<S>& solver,
+                 Formula& formula, const Options& options) {
+    Snapshot snapshot(filename);
+    const Snapshot::Header& header = snapshot.getHeader();
+    solver = std::make_unique<S>((int)header.vars, (int)header.clauses,
+                                 options);
+    solver->load(snapshot);
+    formula = snapshot.formula();
+    // Local search phases for rephasing
+    solver->walker = Walker::provider(formula);
+    // Each constraint is k, its literals and 0
+    const std::vector<int>& constraints = formula.getCardinalities();
+    if (!constraints.empty()) {
+        auto cards = std::make_unique<Cardinality>(formula.getVars());
+        for (std::size_t i = 0; i < constraints.size();) {
+            std::size_t end = i + 1;
+            while (constraints[end])
+                end++;
+            cards->add(&constraints[i + 1], (int)(end - i - 1),
+                       constraints[i]);
+            i = end + 1;
+        }
+        solver->attach(std::move(cards));
+    }
+    if (solver->inconsistent)
+        return UNSAT;
+    // Hand the XORs of the clauses to Gaussian elimination
+    if (header.xors && options.xors)
+        if (auto xors = Gauss::create(formula))
+            return solver->attach(std::move(xors));
+    return SAT;
+}
+
+// -----------------------------------------------------------------------------
+// Whether the fast paths may decide formula
+bool driver::fastPath(const Formula& formula, const Options& options) {
+    return options.fast_paths && options.proof.empty() &&
+           formula.getCardinalities().empty();
+}
+
+// Batch parses into the default solver
+template int driver::parse<Solver>(const std::string& filename,
+                           std::unique_ptr<Solver>& solver, Formula& formula,
+                           const Options& options);
+
 // -----------------------------------------------------------------------------
 // driver instructions
 void driver::instructions() {
@@ -113,5 +461,64 @@ void driver::instructions() {
                  "\t-h,--help\tShow this help message\n"
                  "\t-f <file>\tDIMACS cnf file\n"
                  "\t-s,--stats\tPrint statistics\n"
+                 "\t--batch <src>\tSolve every file of a directory or list\n"
+                 "\t-j <n>\t\tNumber of threads (batch, parsing, served "
+                 "sessions)\n"
+                 "\t--serve <path>\tServe requests on a Unix socket (- for "
+                 "stdin)\n"
+                 "\t--budget <n>\tMaximum conflicts per served solve\n"
+                 "\t--coordinator <addr>  Solve -f with the workers connecting "
+                 "to\n"
+                 "\t\t\taddr (host:port for TCP, or a Unix socket path)\n"
+                 "\t--worker <addr>\tSolve the jobs of the coordinator at "
+                 "addr\n"
+                 "\t--cubes <n>\tCoordinator: split on n variables "
+                 "(0: portfolio)\n"
+                 "\t--share <n>\tWorker: share the lemmas of at most n "
+                 "literals (2)\n"
+                 "\t--restart <p>\tRestart policy: glucose (default), luby,\n"
+                 "\t\t\tgeometric, stable, switch (focused/stable)\n"
+                 "\t--target <n>\tDecide target phases: 0 never, 1 in "
+                 "stable mode\n"
+                 "\t\t\t(default), 2 always\n"
+                 "\t--rephase\tReset the saved phases periodically\n"
+                 "\t--chrono <n>\tBacktrack one level instead of backjumping "
+                 "more than\n"
+                 "\t\t\tn levels (0: never; 100 is usual)\n"
+                 "\t--maxsat\tRead -f as WCNF and find an optimum "
+                 "(core-guided,\n"
+                 "\t\t\tOLL with stratification)\n"
+                 "\t--all\t\tEnumerate the models (projected on the "
+                 "variables of\n"
+                 "\t\t\t\"c p show\" lines, if any)\n"
+                 "\t--models <n>\tEnumerate at most n models\n"
+                 "\t--local-search\tOnly run local search (ProbSAT)\n"
+                 "\t--flips <n>\tMaximum flips of the local search (10^8;\n"
+                 "\t\t\t-1: no limit)\n"
+                 "\t--symmetry\tAdd symmetry-breaking clauses before solving\n"
+                 "\t--symmetry-time <s>  Time limit of the symmetry search\n"
+                 "\t--cardinality\tReplace at-most-one cliques of binary "
+                 "clauses\n"
+                 "\t--no-xor\tDon't recognize XORs (Gaussian elimination)\n"
+                 "\t--no-minimize\tDon't minimize the learned clauses\n"
+                 "\t--no-simd\tScan long clauses one literal at a time\n"
+                 "\t--no-fast-paths  Search on 2-CNF and Horn formulas too\n"
+                 "\t--proof <file>\tWrite a DRAT proof of unsatisfiability\n"
+                 "\t--dump-snapshot <file>  Save the preprocessed formula\n"
+                 "\t--load-snapshot <file>  Solve a saved formula (no -f)\n"
+                 "\t--checkpoint <file>\tSave the search periodically, on "
+                 "SIGUSR1,\n"
+                 "\t\t\tand before stopping on SIGTERM or SIGINT\n"
+                 "\t--checkpoint-interval <s>  Seconds between checkpoints "
+                 "(300)\n"
+                 "\t--resume <file>\tContinue the search of a checkpoint "
+                 "(with the\n"
+                 "\t\t\tsame options), checkpointing to it\n"
+                 "\t--trace <file>\tWrite the events of the search (Chrome "
+                 "trace JSON)\n"
+                 "\t\t\ton exit and on SIGUSR2\n"
+                 "\t--trace-events <n>  Latest events kept for the trace "
+                 "(1048576)\n"
+                 "\t-v,--verbose\tPrint a line for each restart\n"
               << std::endl;
 }
@@ -18,20 +18,61 @@
 
 #endif
 
+#include "formula.hpp"
 #include "solver.hpp"
+#include <memory>
 #include <utility>
 
 namespace microsat {
 
+class Writer;
+
 class driver {
   private:
     const std::string filename;
     bool stats;
-    std::unique_ptr<Solver> solver = nullptr;
-    int parse();
+    Options options;
+    Formula formula;   // Copy of the input clauses to check the model
+    int exit_code = 0; // 10 for SAT, 20 for UNSAT (competition format)
+
+    // Solves the file with the solver S, one of the combinations of policies
+    // instantiated in solver.cpp
+    template <class S> void run();
+    // Enumerates the models (see Options::models), writing them to out;
+    // returns their number
+    template <class S> long long enumerate(S& solver, Writer& out);
+    // Checkpoints the search of solver (see Options::checkpoint)
+    template <class S> void checkpoints(S& solver);
+    // Records the events of the search of solver (see Options::trace)
+    template <class S> void traces(S& solver);
+
+    // Adds the KNF constraint that at least k of the literals (negated on
+    // return) are true; returns UNSAT if the formula became unsatisfiable
+    template <class S>
+    static int addAtLeast(S& s, Formula& formula,
+                          std::unique_ptr<Cardinality>& cards, int k,
+                          std::vector<int>& literals);
 
   public:
-    explicit driver(std::string file, bool stats = false);
+    explicit driver(std::string file, bool stats = false,
+                    Options options = {});
+
+    // Parses a DIMACS file into solver (created or reset) and formula
+    template <class S>
+    static int parse(const std::string& filename, std::unique_ptr<S>& solver,
+                     Formula& formula, const Options& options = {});
+
+    // Loads a snapshot into solver (created) and formula
+    template <class S>
+    static int load(const std::string& filename, std::unique_ptr<S>& solver,
+                    Formula& formula, const Options& options = {});
+
+    // Whether the fast paths of the tractable fragments (tractable.hpp) may
+    // decide formula instead of the search: they write no DRAT proof and
+    // don't read KNF constraints
+    static bool fastPath(const Formula& formula, const Options& options);
+
+    [[nodiscard]] int exitCode() const { return exit_code; }
 
     static void instructions();
 };
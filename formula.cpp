@@ -0,0 +1,57 @@
+//  ----------------------------------------------------------------------------
+//  Implementation file for the Formula class.                       formula.cpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#include "formula.hpp"
+
+#include <cstdlib>
+
+using namespace microsat;
+
+// -----------------------------------------------------------------------------
+// Appends a clause stored in *in of size size
+void Formula::addClause(const int* in, int size) {
+    literals.insert(literals.end(), in, in + size);
+    literals.push_back(0);
+    nClauses++;
+}
+
+// -----------------------------------------------------------------------------
+// Appends the constraint that at most k literals of *in are true
+void Formula::addCardinality(const int* in, int size, int k) {
+    cardinalities.push_back(k);
+    cardinalities.insert(cardinalities.end(), in, in + size);
+    cardinalities.push_back(0);
+}
+
+// -----------------------------------------------------------------------------
+// Returns the index of the first clause falsified by model, or -1
+int Formula::check(const int* model) const {
+    int index = 0;
+    bool satisfied = false;
+    for (int literal : literals) {
+        if (literal == 0) { // End of the clause
+            if (!satisfied)
+                return index;
+            satisfied = false;
+            index++;
+        } else if (!satisfied && (std::abs(literal) <= nVars) &&
+                   ((literal > 0) == (model[std::abs(literal)] != 0))) {
+            satisfied = true;
+        }
+    }
+    // Every clause has a true literal; count those of the constraints
+    for (std::size_t i = 0; i < cardinalities.size(); index++) {
+        int k = cardinalities[i++], count = 0;
+        for (; cardinalities[i]; i++) {
+            int literal = cardinalities[i];
+            count += (literal > 0) == (model[std::abs(literal)] != 0);
+        }
+        i++;
+        if (count > k)
+            return index;
+    }
+    return -1;
+}
@@ -0,0 +1,60 @@
+//  ----------------------------------------------------------------------------
+//  Header file for the Formula class.                               formula.hpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#ifndef MICROSAT_FORMULA_HPP
+#define MICROSAT_FORMULA_HPP
+
+#include <utility>
+#include <vector>
+
+namespace microsat {
+
+// -----------------------------------------------------------------------------
+// A compact copy of the input clauses (and at-most-k constraints). The solver
+// rewrites its own clauses (watch swaps, lemma reduction), so the model is
+// checked against this copy.
+class Formula {
+  private:
+    int nVars = 0;                  // The number of variables
+    int nClauses = 0;               // The number of clauses stored
+    std::vector<int> literals;      // All clauses, each terminated by a 0
+    std::vector<int> cardinalities; // Each constraint: k, literals, 0
+    std::vector<int> shown;         // The variables of "c p show" lines
+
+  public:
+    explicit Formula(int vars = 0) : nVars(vars) {}
+    // The formula of clauses clauses stored in literals and of the
+    // constraints stored in cardinalities
+    Formula(int vars, int clauses, std::vector<int> literals,
+            std::vector<int> cardinalities)
+        : nVars(vars), nClauses(clauses), literals(std::move(literals)),
+          cardinalities(std::move(cardinalities)) {}
+
+    // Appends a clause stored in *in of size size
+    void addClause(const int* in, int size);
+    // Appends the constraint that at most k literals of *in are true
+    void addCardinality(const int* in, int size, int k);
+    // Adds var to the projection (the variables shown)
+    void show(int var) { shown.push_back(var); }
+    // Returns the index of the first clause falsified by model, or -1
+    // (model[v] is non-zero iff variable v is true); the constraints come
+    // after the clauses
+    [[nodiscard]] int check(const int* model) const;
+
+    [[nodiscard]] int getVars() const { return nVars; }
+    [[nodiscard]] int getClauses() const { return nClauses; }
+    [[nodiscard]] const std::vector<int>& getLiterals() const {
+        return literals;
+    }
+    [[nodiscard]] const std::vector<int>& getCardinalities() const {
+        return cardinalities;
+    }
+    [[nodiscard]] const std::vector<int>& getShown() const { return shown; }
+};
+
+} // namespace microsat
+
+#endif // MICROSAT_FORMULA_HPP
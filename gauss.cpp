@@ -0,0 +1,236 @@
+//  ----------------------------------------------------------------------------
+//  Implementation file for the Gauss class.                           gauss.cpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#include "gauss.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+
+using namespace microsat;
+
+namespace {
+
+// -----------------------------------------------------------------------------
+// Adds row src to row dst from word first on (plain word loop that the
+// compiler turns into vector instructions where the target has them)
+void addRow(std::uint64_t* __restrict dst, const std::uint64_t* __restrict src,
+            int first, int words) {
+    for (int i = first; i < words; i++)
+        dst[i] ^= src[i];
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// Recognizes and eliminates the XORs of formula
+Gauss::Gauss(const Formula& formula)
+    : nVars(formula.getVars()), watches(formula.getVars() + 1) {
+    std::vector<int> vars, start;
+    recognize(formula, vars, start);
+    eliminate(vars, start);
+    // Watch the first two variables of every row
+    for (int r = 0; r < getRows(); r++)
+        for (int i = 0; i < 2; i++) {
+            int var = row_vars[row_start[r] + i];
+            watched.push_back(var);
+            watches[var].push_back(r);
+        }
+}
+
+// -----------------------------------------------------------------------------
+// Recognizes the XORs of formula; nullptr if there are none
+std::unique_ptr<Gauss> Gauss::create(const Formula& formula) {
+    auto gauss = std::make_unique<Gauss>(formula);
+    if (!gauss->nXors)
+        return nullptr;
+    return gauss;
+}
+
+// -----------------------------------------------------------------------------
+// Collects the XORs of formula as rows: the variables of row r are
+// vars[start[r]..start[r+1]-1) and the last one is the parity
+void Gauss::recognize(const Formula& formula, std::vector<int>& vars,
+                      std::vector<int>& start) {
+    // The sign patterns (bit i: literal i is negative) found for each set
+    // of variables, listed in increasing order
+    std::map<std::vector<int>, std::uint64_t> patterns;
+    std::vector<int> clause, key;
+    for (int literal : formula.getLiterals()) {
+        if (literal) {
+            clause.push_back(literal);
+            continue;
+        }
+        int size = (int)clause.size();
+        if (size >= 2 && size <= size_max) {
+            std::sort(clause.begin(), clause.end(), [](int a, int b) {
+                return std::abs(a) < std::abs(b);
+            });
+            key.clear();
+            std::uint64_t pattern = 0;
+            for (int i = 0; i < size; i++) {
+                key.push_back(std::abs(clause[i]));
+                if (clause[i] < 0)
+                    pattern |= 1u << i;
+            }
+            // Variables occurring twice never belong to an XOR
+            if (std::adjacent_find(key.begin(), key.end()) == key.end())
+                patterns[key] |= std::uint64_t(1) << pattern;
+        }
+        clause.clear();
+    }
+    start.push_back(0);
+    for (auto& [set, found] : patterns) {
+        int size = (int)set.size();
+        // Split the patterns by the parity of their negative literals
+        std::uint64_t odd = 0, even = 0;
+        for (int pattern = 0; pattern < (1 << size); pattern++)
+            if (__builtin_popcount(pattern) & 1)
+                odd |= std::uint64_t(1) << pattern;
+            else
+                even |= std::uint64_t(1) << pattern;
+        // Odd patterns exclude the odd assignments (the XOR is 0) and even
+        // patterns the even ones (the XOR is 1); both: no assignment at all
+        for (int rhs = 0; rhs < 2; rhs++)
+            if ((found & (rhs ? even : odd)) == (rhs ? even : odd)) {
+                vars.insert(vars.end(), set.begin(), set.end());
+                vars.push_back(rhs);
+                start.push_back((int)vars.size());
+                nXors++;
+            }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Reduces the rows to reduced row echelon form; keeps the nonzero ones
+void Gauss::eliminate(const std::vector<int>& vars,
+                      const std::vector<int>& start) {
+    const int rows = nXors;
+    // Number the variables of the XORs as the columns of the matrix
+    std::vector<int> column(nVars + 1, -1), variable;
+    for (int r = 0; r < rows; r++)
+        for (int i = start[r]; i < start[r + 1] - 1; i++)
+            if (column[vars[i]] < 0) {
+                column[vars[i]] = (int)variable.size();
+                variable.push_back(vars[i]);
+            }
+    const int columns = (int)variable.size();
+    const int words = (columns + 1 + 63) / 64; // The parity is the last bit
+    auto bit = [](std::vector<std::uint64_t>& row, int i) {
+        return (row[i / 64] >> (i % 64)) & 1;
+    };
+    row_start.push_back(0);
+    // Too large a matrix: propagate the XORs as they are
+    if ((long long)rows * words * 64 > bits_max) {
+        for (int r = 0; r < rows; r++) {
+            row_vars.insert(row_vars.end(), vars.begin() + start[r],
+                            vars.begin() + start[r + 1] - 1);
+            row_start.push_back((int)row_vars.size());
+            parity.push_back((char)vars[start[r + 1] - 1]);
+        }
+        return;
+    }
+    std::vector<std::uint64_t> matrix((std::size_t)rows * words, 0);
+    for (int r = 0; r < rows; r++) {
+        std::uint64_t* row = &matrix[(std::size_t)r * words];
+        for (int i = start[r]; i < start[r + 1] - 1; i++)
+            row[column[vars[i]] / 64] ^= std::uint64_t(1)
+                                         << (column[vars[i]] % 64);
+        if (vars[start[r + 1] - 1])
+            row[columns / 64] ^= std::uint64_t(1) << (columns % 64);
+    }
+    // Gauss-Jordan elimination: one pivot per column, cleared in all rows
+    int rank = 0;
+    for (int c = 0; c < columns && rank < rows; c++) {
+        const int w = c / 64;
+        const std::uint64_t mask = std::uint64_t(1) << (c % 64);
+        int pivot = rank;
+        while (pivot < rows && !(matrix[(std::size_t)pivot * words + w] & mask))
+            pivot++;
+        if (pivot == rows)
+            continue;
+        std::uint64_t* top = &matrix[(std::size_t)rank * words];
+        if (pivot != rank)
+            std::swap_ranges(top, top + words,
+                             &matrix[(std::size_t)pivot * words]);
+        // The columns left of c are zero in the pivot row
+        for (int r = 0; r < rows; r++)
+            if (r != rank && (matrix[(std::size_t)r * words + w] & mask))
+                addRow(&matrix[(std::size_t)r * words], top, w, words);
+        rank++;
+    }
+    // Zero rows: 0 = 0 is dropped, 0 = 1 is a contradiction
+    std::vector<std::uint64_t> row(words);
+    for (int r = 0; r < rows; r++) {
+        std::copy_n(&matrix[(std::size_t)r * words], words, row.begin());
+        int first = (int)row_vars.size();
+        for (int c = 0; c < columns; c++)
+            if (bit(row, c))
+                row_vars.push_back(variable[c]);
+        int size = (int)row_vars.size() - first;
+        int rhs = (int)bit(row, columns);
+        if (size == 0) {
+            unsatisfiable |= rhs;
+        } else if (size == 1) { // A unit is no row to watch
+            unit_literals.push_back(rhs ? row_vars.back() : -row_vars.back());
+            row_vars.pop_back();
+        } else {
+            row_start.push_back((int)row_vars.size());
+            parity.push_back((char)rhs);
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Appends the literals implied by rows of a single variable
+void Gauss::units(std::vector<int>& out) const {
+    out.insert(out.end(), unit_literals.begin(), unit_literals.end());
+}
+
+// -----------------------------------------------------------------------------
+// Propagates the assignment of var
+bool Gauss::propagate(int var, const int* false_, std::vector<int>& out) {
+    auto assigned = [false_](int v) { return false_[v] || false_[-v]; };
+    // The literal of v that is false (v must be assigned)
+    auto falsified = [false_](int v) { return false_[v] ? v : -v; };
+    std::vector<int>& list = watches[var];
+    for (std::size_t i = 0; i < list.size();) {
+        int r = list[i];
+        int slot = (watched[2 * r] == var) ? 0 : 1;
+        int other = watched[2 * r + 1 - slot];
+        const int* begin = &row_vars[row_start[r]];
+        const int* end = &row_vars[row_start[r + 1]];
+        // Move the watch to another unassigned variable if there is one
+        const int* p = begin;
+        while (p < end && (*p == var || *p == other || assigned(*p)))
+            p++;
+        if (p < end) {
+            watched[2 * r + slot] = *p;
+            watches[*p].push_back(r);
+            list[i] = list.back();
+            list.pop_back();
+            continue;
+        }
+        i++;
+        // All variables but other are assigned: the parity decides other
+        int sum = parity[r];
+        for (p = begin; p < end; p++)
+            if (*p != other)
+                sum ^= (false_[-*p] != 0); // v is true iff -v is false
+        if (assigned(other) && (false_[-other] != 0) == sum)
+            continue; // The row is satisfied
+        bool conflict = assigned(other);
+        out.push_back(conflict ? falsified(other) : (sum ? other : -other));
+        out.push_back(falsified(var));
+        for (p = begin; p < end; p++)
+            if (*p != other && *p != var)
+                out.push_back(falsified(*p));
+        out.push_back(0);
+        if (conflict)
+            return true;
+    }
+    return false;
+}
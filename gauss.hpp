@@ -0,0 +1,69 @@
+//  ----------------------------------------------------------------------------
+//  Header file for the Gauss class.                                   gauss.hpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#ifndef MICROSAT_GAUSS_HPP
+#define MICROSAT_GAUSS_HPP
+
+#include "formula.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace microsat {
+
+// -----------------------------------------------------------------------------
+// XOR constraints recognized in the clauses of a formula. A constraint
+// x1 ^ ... ^ xk = r is written in CNF as the 2^(k-1) clauses over x1..xk
+// with an odd (r = 0) or even (r = 1) number of negative literals. The
+// constraints are put in reduced row echelon form by Gauss-Jordan
+// elimination on a bit-packed matrix, which proves the XORs inconsistent
+// (0 = 1) without any search. The rows of the reduced matrix then propagate
+// during the search: each watches two unassigned variables and, when all
+// but one are assigned, implies the last one (or detects a conflict). The
+// explanations are handed back as clauses: the implied (or a false) literal
+// first, followed by the literal of the variable that triggered it, then
+// the false literals of the other variables of the row.
+class Gauss {
+  private:
+    const static int size_max = 6;       // Longest clauses of a recognized XOR
+    const static int bits_max = 1 << 26; // Largest matrix eliminated
+    int nVars;                           // The number of variables
+    int nXors = 0;                       // The number of recognized XORs
+    bool unsatisfiable = false;          // Some row reduced to 0 = 1
+    std::vector<int> row_start;          // Row r is row_vars[row_start[r]..]
+    std::vector<int> row_vars;           // The variables of all rows
+    std::vector<char> parity;            // The right-hand side of each row
+    std::vector<int> unit_literals;      // Literals of single variable rows
+    std::vector<int> watched;            // The two watched variables of a row
+    std::vector<std::vector<int>> watches; // Rows watching each variable
+
+    // Collects the XORs of formula as rows (variables and parity)
+    void recognize(const Formula& formula, std::vector<int>& vars,
+                   std::vector<int>& start);
+    // Reduces the rows to row echelon form; keeps the nonzero ones
+    void eliminate(const std::vector<int>& vars, const std::vector<int>& start);
+
+  public:
+    explicit Gauss(const Formula& formula);
+
+    // Recognizes the XORs of formula; nullptr if there are none
+    static std::unique_ptr<Gauss> create(const Formula& formula);
+
+    // Appends the literals implied by rows of a single variable
+    void units(std::vector<int>& out) const;
+    // Propagates the assignment of var (false_[l] non-zero iff l is false),
+    // appending an explanation clause (0 terminated) for each implied
+    // literal; returns true (after appending the falsified row) on conflict
+    bool propagate(int var, const int* false_, std::vector<int>& out);
+
+    [[nodiscard]] bool inconsistent() const { return unsatisfiable; }
+    [[nodiscard]] int getXors() const { return nXors; }
+    [[nodiscard]] int getRows() const { return (int)parity.size(); }
+};
+
+} // namespace microsat
+
+#endif // MICROSAT_GAUSS_HPP
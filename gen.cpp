@@ -0,0 +1,105 @@
+//  ----------------------------------------------------------------------------
+//  Main file of the instance generator.                                 gen.cpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#include "generator.hpp"
+#include "tools.hpp"
+#include <iostream>
+#include <sstream>
+
+// -----------------------------------------------------------------------------
+void instructions() {
+    std::cout << "\nUsage: microsat-gen <family> <n> <options>"
+                 "\n\nFamilies (of size n):\n"
+                 "\tksat\t\tRandom k-SAT on n variables\n"
+                 "\tphp\t\tPigeonhole: n + 1 pigeons, n holes\n"
+                 "\tparity\t\tA cycle of 2n XORs on 3n variables (dubois)\n"
+                 "\tcolor\t\tColouring a random graph of n nodes\n"
+                 "\nOption(s):\n"
+                 "\t-h,--help\tShow this help message\n"
+                 "\t--seed <s>\tSeed of the random families (1)\n"
+                 "\t-k <k>\t\tLiterals per k-SAT clause (3)\n"
+                 "\t--ratio <r>\tClauses per k-SAT variable (4.26)\n"
+                 "\t--colors <c>\tColours of the graph (3)\n"
+                 "\t--degree <d>\tAverage degree of the graph (4)\n"
+                 "\t-o <file>\tWrite the formula to file (stdout)\n"
+              << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+// Writes the formula of the family asked for
+int run(int argc, char* argv[]) {
+    std::string family, output;
+    int n = -1, k = 3, colors = 3;
+    double ratio = 4.26, degree = 4;
+    unsigned long long seed = 1;
+    for (int i = 1; i < argc; ++i)
+        if (argv[i] == std::string("-h") || argv[i] == std::string("--help")) {
+            instructions();
+            return 0;
+        } else if (argv[i] == std::string("--seed") && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (argv[i] == std::string("-k") && i + 1 < argc) {
+            k = std::atoi(argv[++i]);
+        } else if (argv[i] == std::string("--ratio") && i + 1 < argc) {
+            ratio = std::atof(argv[++i]);
+        } else if (argv[i] == std::string("--colors") && i + 1 < argc) {
+            colors = std::atoi(argv[++i]);
+        } else if (argv[i] == std::string("--degree") && i + 1 < argc) {
+            degree = std::atof(argv[++i]);
+        } else if (argv[i] == std::string("-o") && i + 1 < argc) {
+            output = argv[++i];
+        } else if (family.empty() && argv[i][0] != '-') {
+            family = argv[i];
+        } else if (n < 0 && argv[i][0] != '-') {
+            n = std::atoi(argv[i]);
+        } else {
+            instructions();
+            throw Fatal("Invalid Parameter: %s\n", argv[i]);
+        }
+    if (family.empty() || n <= 0) {
+        instructions();
+        throw Fatal("A family and a size are needed\n");
+    }
+    microsat::Generator generator(seed);
+    microsat::Formula formula;
+    std::ostringstream comment;
+    comment << "microsat-gen " << family << " " << n;
+    if (family == "ksat") {
+        if (k < 1 || k > n || ratio < 0)
+            throw Fatal("k-SAT needs 1 <= k <= n and a ratio >= 0\n");
+        formula = generator.ksat(n, k, ratio);
+        comment << " -k " << k << " --ratio " << ratio << " --seed " << seed;
+    } else if (family == "php") {
+        formula = generator.pigeonhole(n);
+    } else if (family == "parity") {
+        formula = generator.parity(n);
+    } else if (family == "color") {
+        if (colors < 1 || degree < 0)
+            throw Fatal("colouring needs colours >= 1 and a degree >= 0\n");
+        formula = generator.coloring(n, colors, degree);
+        comment << " --colors " << colors << " --degree " << degree
+                << " --seed " << seed;
+    } else {
+        throw Fatal("Unknown family: %s\n", family.c_str());
+    }
+    FILE* out = output.empty() ? stdout : fopen(output.c_str(), "w");
+    if (!out)
+        throw Fatal("can't write %s\n", output.c_str());
+    microsat::Generator::write(formula, comment.str().c_str(), out);
+    if (out != stdout)
+        fclose(out);
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[]) {
+    try {
+        return run(argc, argv);
+    } catch (Fatal& e) {
+        std::cout << e.what() << "\n";
+        return 1;
+    }
+}
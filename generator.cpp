@@ -0,0 +1,171 @@
+//  ----------------------------------------------------------------------------
+//  Implementation file for the Generator class.                   generator.cpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#include "generator.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace microsat;
+
+// -----------------------------------------------------------------------------
+// Spreads seed over the state (splitmix64), which must not be 0
+Generator::Generator(std::uint64_t seed) {
+    std::uint64_t z = seed + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    this->seed = (z ^ (z >> 31)) | 1;
+}
+
+// -----------------------------------------------------------------------------
+// Returns the next pseudo-random number (xorshift64)
+std::uint64_t Generator::random() {
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    return seed;
+}
+
+// -----------------------------------------------------------------------------
+// Random k-SAT at the clause/variable ratio
+Formula Generator::ksat(int n, int k, double ratio) {
+    Formula formula(n);
+    int m = (int)std::lround(ratio * n);
+    std::vector<int> clause;
+    for (int c = 0; c < m; c++) {
+        clause.clear();
+        while ((int)clause.size() < k) {
+            int var = 1 + below(n);
+            bool fresh = true;
+            for (int literal : clause)
+                fresh = fresh && std::abs(literal) != var;
+            if (fresh)
+                clause.push_back(random() & 1 ? var : -var);
+        }
+        formula.addClause(clause.data(), k);
+    }
+    return formula;
+}
+
+// -----------------------------------------------------------------------------
+// Pigeon p is in hole h: variable p * holes + h + 1
+Formula Generator::pigeonhole(int holes) {
+    int pigeons = holes + 1;
+    Formula formula(pigeons * holes);
+    std::vector<int> clause;
+    for (int p = 0; p < pigeons; p++) { // Every pigeon has a hole
+        clause.clear();
+        for (int h = 0; h < holes; h++)
+            clause.push_back(p * holes + h + 1);
+        formula.addClause(clause.data(), holes);
+    }
+    for (int h = 0; h < holes; h++) // No hole has two
+        for (int p = 0; p < pigeons; p++)
+            for (int q = p + 1; q < pigeons; q++) {
+                int pair[2] = {-(p * holes + h + 1), -(q * holes + h + 1)};
+                formula.addClause(pair, 2);
+            }
+    return formula;
+}
+
+// -----------------------------------------------------------------------------
+// XOR i links variables i and i + 1 (mod 2n) of the cycle and shares
+// variable 2n + (i mod n) with XOR i + n: every variable is in two XORs, so
+// they sum to 0, while their parities sum to 1
+Formula Generator::parity(int n) {
+    Formula formula(3 * n);
+    for (int i = 0; i < 2 * n; i++) {
+        int vars[3] = {i + 1, (i + 1) % (2 * n) + 1, 2 * n + i % n + 1};
+        int parity = (i == 0); // The one odd XOR
+        // The clauses of the XOR: the sign patterns of the wrong parity
+        for (int signs = 0; signs < 8; signs++) {
+            int negative = (signs & 1) + (signs >> 1 & 1) + (signs >> 2 & 1);
+            if (negative % 2 == parity)
+                continue;
+            int clause[3];
+            for (int j = 0; j < 3; j++)
+                clause[j] = signs >> j & 1 ? -vars[j] : vars[j];
+            formula.addClause(clause, 3);
+        }
+    }
+    return formula;
+}
+
+// -----------------------------------------------------------------------------
+// Node v has colour c: variable v * colors + c + 1
+Formula Generator::coloring(int n, int colors, double degree) {
+    Formula formula(n * colors);
+    std::vector<int> clause;
+    for (int v = 0; v < n; v++) { // At least one colour
+        clause.clear();
+        for (int c = 0; c < colors; c++)
+            clause.push_back(v * colors + c + 1);
+        formula.addClause(clause.data(), colors);
+        for (int c = 0; c < colors; c++) // At most one
+            for (int d = c + 1; d < colors; d++) {
+                int pair[2] = {-(v * colors + c + 1), -(v * colors + d + 1)};
+                formula.addClause(pair, 2);
+            }
+    }
+    // A random graph of n * degree / 2 distinct edges
+    long long possible = (long long)n * (n - 1) / 2;
+    long long m = std::min(possible, std::llround(degree * n / 2));
+    std::vector<std::vector<int>> adjacent(n);
+    for (long long e = 0; e < m;) {
+        int u = below(n), v = below(n);
+        if (u == v)
+            continue;
+        if (u > v)
+            std::swap(u, v);
+        bool fresh = true;
+        for (int w : adjacent[u])
+            fresh = fresh && w != v;
+        if (!fresh)
+            continue;
+        adjacent[u].push_back(v);
+        e++;
+        for (int c = 0; c < colors; c++) { // Not the same colour
+            int pair[2] = {-(u * colors + c + 1), -(v * colors + c + 1)};
+            formula.addClause(pair, 2);
+        }
+    }
+    return formula;
+}
+
+// -----------------------------------------------------------------------------
+// Writes formula in DIMACS, after the comment lines of comment
+void Generator::write(const Formula& formula, const char* comment,
+                      FILE* out) {
+    std::string buffer;
+    for (const char* line = comment; *line;) {
+        const char* end = line;
+        while (*end && *end != '\n')
+            end++;
+        buffer += "c ";
+        buffer.append(line, end - line);
+        buffer += '\n';
+        line = *end ? end + 1 : end;
+    }
+    buffer += "p cnf " + std::to_string(formula.getVars()) + " " +
+              std::to_string(formula.getClauses()) + "\n";
+    char number[16];
+    for (int literal : formula.getLiterals()) {
+        auto end = std::to_chars(number, number + sizeof number, literal).ptr;
+        buffer.append(number, end - number);
+        buffer += literal ? ' ' : '\n';
+        if (buffer.size() >= (1u << 20u)) {
+            std::fwrite(buffer.data(), 1, buffer.size(), out);
+            buffer.clear();
+        }
+    }
+    std::fwrite(buffer.data(), 1, buffer.size(), out);
+    std::fflush(out);
+}
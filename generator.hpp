@@ -0,0 +1,51 @@
+//  ----------------------------------------------------------------------------
+//  Header file for the Generator class.                           generator.hpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#ifndef MICROSAT_GENERATOR_HPP
+#define MICROSAT_GENERATOR_HPP
+
+#include "formula.hpp"
+#include <cstdint>
+#include <cstdio>
+
+namespace microsat {
+
+// -----------------------------------------------------------------------------
+// Seeded generator of parameterised instance families, to measure how the
+// solver scales with their size. The same seed gives the same formula on
+// every platform (the generator doesn't use the standard distributions).
+class Generator {
+  private:
+    std::uint64_t seed; // State of the random generator
+
+    // Returns the next pseudo-random number (xorshift64)
+    std::uint64_t random();
+    // A pseudo-random number in [0, bound)
+    int below(int bound) { return (int)(random() % (std::uint64_t)bound); }
+
+  public:
+    explicit Generator(std::uint64_t seed = 1);
+
+    // Random k-SAT: n variables, ratio * n clauses of k distinct variables
+    // (around 4.26 is the hardest for 3-SAT)
+    Formula ksat(int n, int k = 3, double ratio = 4.26);
+    // The pigeonhole principle for holes + 1 pigeons (unsatisfiable)
+    Formula pigeonhole(int holes);
+    // A cycle of 2n XORs of three variables (each in two XORs) of odd total
+    // parity, as in the dubois family (unsatisfiable)
+    Formula parity(int n);
+    // Colouring a random graph of n nodes and average degree degree with
+    // colors colours (at most one per node)
+    Formula coloring(int n, int colors = 3, double degree = 4.0);
+
+    // Writes formula in DIMACS, after the comment lines of comment
+    static void write(const Formula& formula, const char* comment,
+                      FILE* out);
+};
+
+} // namespace microsat
+
+#endif // MICROSAT_GENERATOR_HPP
@@ -5,39 +5,197 @@
 // -----------------------------------------------------------------------------
 
 #include "driver.hpp"
+#include "batch.hpp"
+#include "cluster.hpp"
+#include "maxsat.hpp"
+#include "server.hpp"
+#include "simd.hpp"
 #include "tools.hpp"
 #include <iostream>
+#include <thread>
+
+// -----------------------------------------------------------------------------
+// maps the name of a restart policy to the policy
+microsat::Restarts restarts(const std::string& name) {
+    using microsat::Restarts;
+    if (name == "glucose")
+        return Restarts::glucose;
+    if (name == "luby")
+        return Restarts::luby;
+    if (name == "geometric")
+        return Restarts::geometric;
+    if (name == "stable")
+        return Restarts::stable;
+    if (name == "switch")
+        return Restarts::switching;
+    throw Fatal("Invalid restart policy: %s\n", name.c_str());
+}
 
 // -----------------------------------------------------------------------------
 // initiates the driver with the supplied DIMACS filename
-void run(int argc, char* argv[]) {
+// returns the exit code of the competition format (10: SAT, 20: UNSAT)
+int run(int argc, char* argv[]) {
     bool stats = false;
-    std::string filename;
-    if (argc > 5)
-        throw Fatal("Invalid number of arguments: %i\n", argc - 1);
+    std::string filename, batch, serve, resume, coordinator, worker;
+    int threads = (int)std::thread::hardware_concurrency();
+    int budget = -1;
+    int cubes = 0, share = 2;
+    bool maxsat = false;
+    microsat::Options options;
     for (int i = 1; i < argc; ++i)
         if (argv[i] == std::string("-h") || argv[i] == std::string("--help")) {
             microsat::driver::instructions();
-            return;
+            return 0;
         } else if (argv[i] == std::string("-s") ||
                    argv[i] == std::string("--stats")) {
             stats = true;
-        } else if (argv[i] == std::string("-f")) {
+        } else if (argv[i] == std::string("-f") && i + 1 < argc) {
             filename = argv[++i];
+        } else if (argv[i] == std::string("--batch") && i + 1 < argc) {
+            batch = argv[++i];
+        } else if (argv[i] == std::string("-j") && i + 1 < argc) {
+            threads = std::atoi(argv[++i]);
+            options.threads = threads;
+        } else if (argv[i] == std::string("--serve") && i + 1 < argc) {
+            serve = argv[++i];
+        } else if (argv[i] == std::string("--coordinator") && i + 1 < argc) {
+            coordinator = argv[++i];
+        } else if (argv[i] == std::string("--worker") && i + 1 < argc) {
+            worker = argv[++i];
+        } else if (argv[i] == std::string("--cubes") && i + 1 < argc) {
+            cubes = std::atoi(argv[++i]);
+            if (cubes < 0 || cubes > 20)
+                throw Fatal("--cubes needs 0 to 20 variables\n");
+        } else if (argv[i] == std::string("--share") && i + 1 < argc) {
+            share = std::atoi(argv[++i]);
+        } else if (argv[i] == std::string("--budget") && i + 1 < argc) {
+            budget = std::atoi(argv[++i]);
+        } else if (argv[i] == std::string("--restart") && i + 1 < argc) {
+            options.restarts = restarts(argv[++i]);
+        } else if (argv[i] == std::string("--target") && i + 1 < argc) {
+            options.target = std::atoi(argv[++i]);
+        } else if (argv[i] == std::string("--chrono") && i + 1 < argc) {
+            options.chrono = std::atoi(argv[++i]);
+            if (options.chrono < 0)
+                throw Fatal("--chrono needs a number of levels >= 0\n");
+        } else if (argv[i] == std::string("--rephase")) {
+            options.rephase = true;
+        } else if (argv[i] == std::string("--symmetry")) {
+            options.symmetry = true;
+        } else if (argv[i] == std::string("--symmetry-time") && i + 1 < argc) {
+            options.symmetry_time = std::atof(argv[++i]);
+        } else if (argv[i] == std::string("--cardinality")) {
+            options.cardinality = true;
+        } else if (argv[i] == std::string("--no-xor")) {
+            options.xors = false;
+        } else if (argv[i] == std::string("--no-minimize")) {
+            options.minimize = false;
+        } else if (argv[i] == std::string("--no-fast-paths")) {
+            options.fast_paths = false;
+        } else if (argv[i] == std::string("--no-simd")) {
+            microsat::selectScan(false);
+        } else if (argv[i] == std::string("--proof") && i + 1 < argc) {
+            options.proof = argv[++i];
+        } else if (argv[i] == std::string("--dump-snapshot") &&
+                   i + 1 < argc) {
+            options.dump_snapshot = argv[++i];
+        } else if (argv[i] == std::string("--load-snapshot") &&
+                   i + 1 < argc) {
+            options.load_snapshot = argv[++i];
+        } else if (argv[i] == std::string("--checkpoint") && i + 1 < argc) {
+            options.checkpoint = argv[++i];
+        } else if (argv[i] == std::string("--checkpoint-interval") &&
+                   i + 1 < argc) {
+            options.checkpoint_interval = std::atof(argv[++i]);
+        } else if (argv[i] == std::string("--trace") && i + 1 < argc) {
+            options.trace = argv[++i];
+        } else if (argv[i] == std::string("--trace-events") && i + 1 < argc) {
+            options.trace_events = std::atoll(argv[++i]);
+            if (options.trace_events <= 0)
+                throw Fatal("--trace-events needs a number of events > 0\n");
+        } else if (argv[i] == std::string("--resume") && i + 1 < argc) {
+            resume = argv[++i];
+        } else if (argv[i] == std::string("--maxsat")) {
+            maxsat = true;
+        } else if (argv[i] == std::string("--all")) {
+            options.models = -1;
+        } else if (argv[i] == std::string("--models") && i + 1 < argc) {
+            options.models = std::atoll(argv[++i]);
+        } else if (argv[i] == std::string("--local-search")) {
+            options.local_search = true;
+        } else if (argv[i] == std::string("--flips") && i + 1 < argc) {
+            options.flips = std::atoll(argv[++i]);
+        } else if (argv[i] == std::string("-v") ||
+                   argv[i] == std::string("--verbose")) {
+            options.verbose = true;
         } else {
             microsat::driver::instructions();
             throw Fatal("Invalid Parameter: %s\n", argv[i]);
         }
-    microsat::driver drv(filename, stats);
+    // Distributed solving runs the default solver, on the input file only
+    bool distributed = !coordinator.empty() || !worker.empty();
+    if (!options.proof.empty() &&
+        (!batch.empty() || !serve.empty() || distributed))
+        throw Fatal("--proof needs a single formula (-f)\n");
+    if (!options.trace.empty() &&
+        (!batch.empty() || !serve.empty() || distributed || maxsat ||
+         options.local_search))
+        throw Fatal("--trace needs the search of a single formula\n");
+    // A checkpoint is a snapshot of the search: resuming loads it and goes
+    // on checkpointing (to it, unless told otherwise)
+    if (!resume.empty()) {
+        if (!options.proof.empty())
+            throw Fatal("--resume can't continue a proof\n");
+        options.load_snapshot = resume;
+        if (options.checkpoint.empty())
+            options.checkpoint = resume;
+    }
+    if ((!options.dump_snapshot.empty() || !options.load_snapshot.empty() ||
+         !options.checkpoint.empty()) &&
+        (!batch.empty() || !serve.empty() || distributed))
+        throw Fatal("snapshots need a single formula\n");
+    if (options.models &&
+        (!options.proof.empty() || !options.checkpoint.empty() ||
+         options.local_search || options.symmetry || !batch.empty() ||
+         !serve.empty() || distributed))
+        throw Fatal("--all and --models solve a single formula, without "
+                    "--proof, --checkpoint, --local-search or --symmetry\n");
+    if ((!options.dump_snapshot.empty() || !options.checkpoint.empty()) &&
+        options.cardinality)
+        throw Fatal("--cardinality can't be snapshotted\n");
+    if (maxsat &&
+        (!options.proof.empty() || !options.dump_snapshot.empty() ||
+         !options.load_snapshot.empty() || !options.checkpoint.empty() ||
+         options.models || options.local_search || options.symmetry ||
+         options.cardinality || !batch.empty() || !serve.empty() ||
+         distributed))
+        throw Fatal("--maxsat solves a single WCNF formula (-f), without "
+                    "proofs, snapshots, enumeration, local search, symmetry "
+                    "or cardinality\n");
+    if (maxsat)
+        return microsat::MaxSat(options).run(filename, stats);
+    if (!batch.empty())
+        return microsat::Batch(batch, options).run(threads, stats);
+    if (!serve.empty())
+        return microsat::Server(budget, options).run(serve, threads);
+    if (!coordinator.empty())
+        return microsat::Coordinator(cubes, options)
+            .run(filename, coordinator, stats);
+    if (!worker.empty())
+        return microsat::Worker(share, options).run(worker);
+    microsat::driver drv(filename, stats, options);
+    return drv.exitCode();
 }
 
 // -----------------------------------------------------------------------------
 int main(int argc, char* argv[]) {
     P(banner());
+    int code = 0;
     try {
-        run(argc, argv);
+        code = run(argc, argv);
     } catch (Fatal& e) {
         std::cout << e.what() << "\n";
+        return 1;
     } catch (std::runtime_error& e) {
         std::cerr << "\n\nCatching Runtime Error...\n\n" << e.what() << "\n";
     } catch (std::bad_alloc& e) { // handle memory exhaustion
@@ -48,5 +206,5 @@ int main(int argc, char* argv[]) {
         throw;
     }
     P(bye());
-    return 0;
+    return code;
 }
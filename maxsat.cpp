@@ -0,0 +1,355 @@
+//  ----------------------------------------------------------------------------
+//  Implementation file for the MaxSat class.                         maxsat.cpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#include "maxsat.hpp"
+
+#include "tools.hpp"
+#include "writer.hpp"
+#include <algorithm>
+#include <climits>
+#include <fstream>
+#include <sstream>
+
+using namespace microsat;
+
+// -----------------------------------------------------------------------------
+// Reads the WCNF file: a "p wcnf" line gives the variables, the clauses and
+// the weight of the hard clauses (top, none: every clause is soft);
+// without it, the hard clauses start with "h". The other clauses start with
+// their weight.
+void MaxSat::read(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file)
+        throw Fatal("can't open %s", filename.c_str());
+    std::uint64_t top = UINT64_MAX;
+    int declared = -1; // Variables of the problem line, if any
+    std::string line, token;
+    std::vector<int> clause;
+    while (std::getline(file, line)) {
+        std::istringstream in(line);
+        if (!(in >> token) || token[0] == 'c')
+            continue;
+        if (token == "p") {
+            std::string format;
+            int clauses = 0;
+            if (!(in >> format >> declared >> clauses) || format != "wcnf" ||
+                declared < 0)
+                throw Fatal("bad problem line in %s", filename.c_str());
+            if (!(in >> top))
+                top = UINT64_MAX;
+            inputs = std::max(inputs, declared);
+            continue;
+        }
+        std::uint64_t weight = top;
+        if (token != "h") {
+            std::istringstream number(token);
+            if (token[0] == '-' || !(number >> weight) || !number.eof())
+                throw Fatal("bad weight %s in %s", token.c_str(),
+                            filename.c_str());
+        }
+        clause.clear();
+        long long literal = 0;
+        while (in >> literal && literal) {
+            if (std::abs(literal) > INT_MAX ||
+                (declared >= 0 && std::abs(literal) > declared))
+                throw Fatal("literal %lli out of range", literal);
+            clause.push_back((int)literal);
+            inputs = std::max(inputs, (int)std::abs(literal));
+        }
+        if (literal)
+            throw Fatal("clause without 0 in %s", filename.c_str());
+        if (weight >= top) {
+            hard.insert(hard.end(), clause.begin(), clause.end());
+            hard.push_back(0);
+        } else if (weight) {
+            softs.insert(softs.end(), clause.begin(), clause.end());
+            softs.push_back(0);
+            weights.push_back(weight);
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// A new variable: the solver is made again twice as large when it has no
+// room for it
+int MaxSat::fresh() {
+    if (solver && vars == capacity)
+        build(2 * capacity);
+    return ++vars;
+}
+
+// -----------------------------------------------------------------------------
+// Creates the solver with room for capacity variables and adds the hard
+// clauses (the lemmas of the previous solver, if any, are lost)
+void MaxSat::build(int capacity) {
+    rebuilds += solver != nullptr;
+    this->capacity = capacity;
+    int clauses = (int)std::count(hard.begin(), hard.end(), 0);
+    solver = std::make_unique<Solver>(capacity, clauses, options);
+    std::vector<int> clause;
+    for (int literal : hard)
+        if (literal) {
+            clause.push_back(literal);
+        } else {
+            unsat = unsat ||
+                    solver->addInput(clause.data(), (int)clause.size()) ==
+                        UNSAT;
+            clause.clear();
+        }
+}
+
+// -----------------------------------------------------------------------------
+// Adds a hard clause, to the solver too if there is one
+void MaxSat::add(std::vector<int> clause) {
+    hard.insert(hard.end(), clause.begin(), clause.end());
+    hard.push_back(0);
+    if (solver && !unsat)
+        unsat = solver->addInput(clause.data(), (int)clause.size()) == UNSAT;
+}
+
+// -----------------------------------------------------------------------------
+// Adds literal to the objective with weight (to its weight if it is there)
+void MaxSat::soft(int literal, std::uint64_t weight, int totalizer,
+                  int bound) {
+    auto position = positions.find(literal);
+    if (position != positions.end()) {
+        objective[position->second].weight += weight;
+        return;
+    }
+    positions[literal] = (int)objective.size();
+    objective.push_back({literal, weight, totalizer, bound});
+}
+
+// -----------------------------------------------------------------------------
+// Builds a balanced totalizer of the negations of literals, without outputs
+// above the leaves yet
+int MaxSat::totalize(const std::vector<int>& literals) {
+    std::vector<int> level, above;
+    for (int literal : literals) {
+        level.push_back((int)nodes.size());
+        nodes.emplace_back();
+        nodes.back().outputs.push_back(-literal);
+    }
+    while (level.size() > 1) {
+        above.clear();
+        for (std::size_t i = 0; i + 1 < level.size(); i += 2) {
+            above.push_back((int)nodes.size());
+            nodes.emplace_back();
+            Node& node = nodes.back();
+            node.left = level[i];
+            node.right = level[i + 1];
+            node.size = nodes[level[i]].size + nodes[level[i + 1]].size;
+        }
+        if (level.size() % 2)
+            above.push_back(level.back());
+        level.swap(above);
+    }
+    roots.push_back(level[0]);
+    return (int)roots.size() - 1;
+}
+
+// -----------------------------------------------------------------------------
+// Extends the outputs of node to bound (at most its inputs): output j is
+// implied by output i of the left child and output j - i of the right one,
+// only the outputs new since the last extension getting their clauses
+void MaxSat::extend(int node, int bound) {
+    bound = std::min(bound, nodes[node].size);
+    int built = (int)nodes[node].outputs.size();
+    if (built >= bound)
+        return;
+    extend(nodes[node].left, bound);
+    extend(nodes[node].right, bound);
+    for (int j = built; j < bound; j++) {
+        int output = fresh();
+        nodes[node].outputs.push_back(output);
+    }
+    const std::vector<int> left = nodes[nodes[node].left].outputs;
+    const std::vector<int> right = nodes[nodes[node].right].outputs;
+    const std::vector<int> outputs = nodes[node].outputs;
+    for (int j = built + 1; j <= bound; j++)
+        for (int i = std::max(0, j - (int)right.size());
+             i <= std::min(j, (int)left.size()); i++) {
+            std::vector<int> clause;
+            if (i)
+                clause.push_back(-left[i - 1]);
+            if (j - i)
+                clause.push_back(-right[j - i - 1]);
+            clause.push_back(outputs[j - 1]);
+            add(clause);
+        }
+}
+
+// -----------------------------------------------------------------------------
+// Relaxes the core found by the solver: raises the lower bound by its
+// minimum weight, takes it off its literals and adds it to the outputs that
+// allow one more of them false
+void MaxSat::relax() {
+    std::vector<int> core = solver->getCore();
+    std::uint64_t weight = UINT64_MAX;
+    for (int literal : core)
+        weight = std::min(weight, objective[positions[literal]].weight);
+    lower += weight;
+    cores++;
+    if (options.verbose)
+        printf("c core of %zu literals, weight %llu, lower bound %llu\n",
+               core.size(), (unsigned long long)weight,
+               (unsigned long long)lower);
+    for (int literal : core) {
+        Soft& relaxed = objective[positions[literal]];
+        relaxed.weight -= weight;
+        int totalizer = relaxed.totalizer, bound = relaxed.bound + 1;
+        if (totalizer < 0 || bound > nodes[roots[totalizer]].size)
+            continue;
+        extend(roots[totalizer], bound);
+        soft(-nodes[roots[totalizer]].outputs[bound - 1], weight, totalizer,
+             bound);
+    }
+    if (core.size() > 1) {
+        int totalizer = totalize(core);
+        extend(roots[totalizer], 2);
+        soft(-nodes[roots[totalizer]].outputs[1], weight, totalizer, 2);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// The cost of model (the weight of the soft clauses it falsifies)
+std::uint64_t MaxSat::cost(const int* model) const {
+    std::uint64_t sum = 0;
+    bool satisfied = false;
+    for (std::size_t i = 0, clause = 0; i < softs.size(); i++)
+        if (!softs[i]) {
+            if (!satisfied)
+                sum += weights[clause];
+            satisfied = false;
+            clause++;
+        } else if (model[std::abs(softs[i])] == (softs[i] > 0)) {
+            satisfied = true;
+        }
+    return sum;
+}
+
+// -----------------------------------------------------------------------------
+// Hardens the literals whose weight would raise the lower bound above the
+// cost of the best model: the models at least as good satisfy them
+void MaxSat::harden() {
+    for (Soft& literal : objective)
+        if (literal.weight && upper != UINT64_MAX &&
+            lower + literal.weight > upper) {
+            literal.weight = 0;
+            add({literal.literal});
+        }
+}
+
+// -----------------------------------------------------------------------------
+// Solves the WCNF file: OLL with stratification
+int MaxSat::run(const std::string& filename, bool stats) {
+    read(filename);
+    vars = inputs;
+    // The objective: the unit soft clauses are their own literal, the others
+    // are implied by a new variable
+    std::vector<int> clause;
+    for (std::size_t i = 0, start = 0, index = 0; i < softs.size(); i++) {
+        if (softs[i])
+            continue;
+        clause.assign(softs.begin() + start, softs.begin() + i);
+        std::uint64_t weight = weights[index++];
+        start = i + 1;
+        std::sort(clause.begin(), clause.end());
+        clause.erase(std::unique(clause.begin(), clause.end()), clause.end());
+        bool tautology = false;
+        for (int literal : clause)
+            tautology = tautology ||
+                        std::binary_search(clause.begin(), clause.end(),
+                                           -literal);
+        if (tautology)
+            continue;
+        if (clause.empty()) {
+            falsified += weight;
+        } else if (clause.size() == 1) {
+            soft(clause[0], weight);
+        } else {
+            int relaxation = fresh();
+            clause.push_back(-relaxation);
+            add(clause);
+            soft(relaxation, weight);
+        }
+    }
+    lower = falsified;
+    // Room for the totalizers, as many variables again
+    build(std::max(2 * vars, vars + 1024));
+    std::uint64_t stratum = 0;
+    for (const Soft& literal : objective)
+        stratum = std::max(stratum, literal.weight);
+    Writer out;
+    std::vector<int> assumptions;
+    while (!unsat) {
+        assumptions.clear();
+        for (const Soft& literal : objective)
+            if (literal.weight && literal.weight >= stratum)
+                assumptions.push_back(literal.literal);
+        solver->assume(assumptions.data(), (int)assumptions.size());
+        if (solver->solve() == UNSAT) {
+            if (solver->getCore().empty()) { // The hard clauses
+                unsat = best.empty();
+                break;
+            }
+            relax();
+            harden();
+            continue;
+        }
+        const int* model = solver->getModel();
+        for (std::size_t i = 0, start = 0; i < hard.size(); i++)
+            if (!hard[i]) {
+                bool satisfied = false;
+                for (std::size_t j = start; j < i; j++)
+                    satisfied = satisfied ||
+                                model[std::abs(hard[j])] == (hard[j] > 0);
+                if (!satisfied)
+                    throw Fatal("c model check failed: a hard clause is "
+                                "falsified");
+                start = i + 1;
+            }
+        std::uint64_t found = cost(model);
+        if (found < upper) {
+            upper = found;
+            best.assign(model, model + inputs + 1);
+            out.text(("o " + std::to_string(upper) + "\n").c_str());
+            out.flush();
+        }
+        // Every literal assumed: the model is optimal
+        std::uint64_t next = 0;
+        for (const Soft& literal : objective)
+            if (literal.weight < stratum)
+                next = std::max(next, literal.weight);
+        if (lower >= upper || !next)
+            break;
+        stratum = next;
+        harden();
+    }
+    if (unsat) {
+        out.status(UNSAT);
+    } else {
+        out.text("s OPTIMUM FOUND\n");
+        out.model(best.data(), inputs);
+    }
+    if (stats) {
+        std::ostringstream line;
+        line << "statistics of " << filename << ":";
+        out.comment(line.str().c_str());
+        line.str("");
+        line << "[ cost: ";
+        if (unsat)
+            line << "none";
+        else
+            line << upper;
+        line << ", cores: " << cores << ", totalizers: " << roots.size()
+             << ", variables: " << vars << ", rebuilds: " << rebuilds
+             << ", mem_used: " << solver->mem_used() << " ]";
+        out.comment(line.str().c_str());
+    }
+    out.flush();
+    return unsat ? 20 : 30;
+}
@@ -0,0 +1,116 @@
+//  ----------------------------------------------------------------------------
+//  Header file for the MaxSat class.                                 maxsat.hpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#ifndef MICROSAT_MAXSAT_HPP
+#define MICROSAT_MAXSAT_HPP
+
+#include "solver.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace microsat {
+
+// -----------------------------------------------------------------------------
+// Weighted partial MaxSAT (WCNF, the "p wcnf" format with its top weight or
+// the newer one with "h" for the hard clauses): finds an assignment
+// satisfying the hard clauses that minimizes the weight of the soft clauses
+// it falsifies. The core-guided algorithm OLL (Andres, Kaufmann, Matheis &
+// Schaub, 2012; Morgado, Dodaro & Marques-Silva, 2014) runs in one solver,
+// which keeps its lemmas from a call to the next:
+//   - every soft clause is a literal of the objective (the clause itself if
+//     it is a unit, otherwise a new variable implying it), assumed true;
+//   - an UNSAT core of these assumptions, of minimum weight w, raises the
+//     lower bound by w and takes w off its literals; a totalizer counts
+//     how many of them are false, and the objective gets "fewer than 2"
+//     with weight w. When the literal "fewer than k" of a totalizer is in a
+//     core, "fewer than k+1" follows. The totalizers grow their outputs
+//     only as far as the bounds asked (Martins, Joshi, Manquinho & Lynce,
+//     2014);
+//   - stratification: only the literals of weight at least a stratum are
+//     assumed, the stratum lowered to the next weight on every model. A
+//     model with every literal assumed is optimal;
+//   - every model is an upper bound, and a literal whose weight would
+//     raise the lower bound past it is hardened (added as a unit).
+// The solver can't add variables: it is created with room for more, and
+// made again (from the clauses) twice as large when they run out.
+class MaxSat {
+  private:
+    // A literal of the objective: assumed true, its weight counted when it
+    // is false
+    struct Soft {
+        int literal;
+        std::uint64_t weight;
+        int totalizer = -1; // Whose output "fewer than bound" it is, if any
+        int bound = 0;
+    };
+    // A node of a totalizer: outputs[k-1] is implied by k of its inputs
+    // true (the leaves: their input), for k up to the bound asked so far
+    struct Node {
+        int left = -1, right = -1; // Children (-1: a leaf)
+        int size = 1;              // Inputs below it
+        std::vector<int> outputs;
+    };
+
+    const Options options;
+    int inputs = 0;   // Variables of the input
+    int vars = 0;     // Variables in use
+    int capacity = 0; // Variables of the solver
+    std::vector<int> hard;  // The hard clauses (and those of the encodings),
+                            // each terminated by 0
+    std::vector<int> softs; // The soft clauses likewise
+    std::vector<std::uint64_t> weights; // And their weights
+    std::uint64_t falsified = 0;        // Weight of the empty soft clauses
+    std::vector<Soft> objective;
+    std::unordered_map<int, int> positions; // Of the literals in objective
+    std::vector<Node> nodes; // Of all totalizers
+    std::vector<int> roots;  // The root node of each totalizer
+    std::unique_ptr<Solver> solver;
+    std::uint64_t lower = 0;          // Lower bound of the optimum
+    std::uint64_t upper = UINT64_MAX; // Cost of the best model, if any
+    std::vector<int> best;            // Best model so far
+    int cores = 0;      // Cores found
+    int rebuilds = 0;   // Solvers made again larger
+    bool unsat = false; // The hard clauses are unsatisfiable
+
+    // Reads the WCNF file
+    void read(const std::string& filename);
+    // A new variable, making the solver again larger if needed
+    int fresh();
+    // Creates the solver with room for capacity variables and adds the
+    // hard clauses
+    void build(int capacity);
+    // Adds a hard clause
+    void add(std::vector<int> clause);
+    // Adds literal to the objective with weight
+    void soft(int literal, std::uint64_t weight, int totalizer = -1,
+              int bound = 0);
+    // Builds a totalizer of the negations of literals; returns its index
+    int totalize(const std::vector<int>& literals);
+    // Extends the outputs of node to bound
+    void extend(int node, int bound);
+    // Relaxes the core found by the solver
+    void relax();
+    // The cost of model (the weight of the soft clauses it falsifies)
+    std::uint64_t cost(const int* model) const;
+    // Hardens the literals whose weight no model better than the best
+    // one can afford
+    void harden();
+
+  public:
+    explicit MaxSat(Options options = {}) : options(options) {}
+
+    // Solves the WCNF file, writing "o" lines for the better models found
+    // and then the result; returns the exit code of the MaxSAT evaluation
+    // (30: optimum, 20: hard clauses UNSAT)
+    int run(const std::string& filename, bool stats = false);
+};
+
+} // namespace microsat
+
+#endif // MICROSAT_MAXSAT_HPP
@@ -21,7 +21,12 @@
 
 
 #include "tools.hpp"
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <new>
+#include <sys/mman.h>
+#include <utility>
 #include <vector>
 
 namespace microsat {
@@ -33,24 +38,50 @@ template <typename T> class Memory {
 
   private:
     const std::size_t max;
-    T* memory;
+    T* memory = nullptr;
     std::size_t used = 0;
+    std::size_t high = 0;  // The most ever used: the pages committed
+    // The ranges (start, size) released in the used part, but never reused
+    std::vector<std::pair<std::size_t, std::size_t>> freed;
 
   public:
     using value_type = T;
 
-    explicit Memory(int mem_max) noexcept : max(mem_max), memory(new int[max]) {
+    // Reserves (without committing) the address space of mem_max elements:
+    // the pages are only backed by memory once they are used
+    explicit Memory(std::size_t mem_max) : max(mem_max) {
         PRINT("Memory::mem_max " << mem_max * sizeof(T) << " bytes");
+        void* map = mmap(nullptr, max * sizeof(T), PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (map == MAP_FAILED)
+            throw std::bad_alloc();
+        memory = static_cast<T*>(map);
     }
+    Memory(const Memory&) = delete;
+    Memory& operator=(const Memory&) = delete;
 
     ~Memory() {
         PRINT("Memory::~Memory()");
-        delete[] memory;
+        munmap(memory, max * sizeof(T));
     }
 
-    [[nodiscard]] int mem_used() const { return used; } // make it const later
+    [[nodiscard]] std::size_t mem_used() const { return used; }
 
-    [[nodiscard]] int mem_max() const { return max; }
+    [[nodiscard]] std::size_t mem_max() const { return max; }
+
+    [[nodiscard]] std::size_t mem_high() const { return high; }
+
+    // The elements released between begin and end (all by default)
+    [[nodiscard]] std::size_t mem_freed(std::size_t begin = 0,
+                                        std::size_t end = SIZE_MAX) const {
+        std::size_t sum = 0;
+        for (const auto& range : freed) {
+            std::size_t low = std::max(range.first, begin);
+            std::size_t high = std::min(range.first + range.second, end);
+            sum += high > low ? high - low : 0;
+        }
+        return sum;
+    }
 
     // -------------------------------------------------------------------------
     // allocates memory for pointers
@@ -63,6 +94,7 @@ template <typename T> class Memory {
         // Compute a pointer to the new memory location
         value_type* store = memory + used;
         used += mem_size; // Update the size of the used
+        high = std::max(high, used);
         PRINT("Allocator::used " << used);
         return store;
     }
@@ -86,7 +118,38 @@ template <typename T> class Memory {
         return vector;
     }
 
-    void resize(std::size_t size) { used = size; };
+    // Sets the used part to size: the released ranges above it are
+    // forgotten (cut at size), the memory being reused
+    void resize(std::size_t size) {
+        used = size;
+        high = std::max(high, used);
+        std::size_t kept = 0;
+        for (const auto& range : freed)
+            if (range.first < used)
+                freed[kept++] = {range.first,
+                                 std::min(range.second, used - range.first)};
+        freed.resize(kept);
+    };
+    // Records that the size elements at p are released: the memory is only
+    // reused once it is resized below them
+    void release(value_type* p, std::size_t size) {
+        if (p >= memory && p + size <= memory + used)
+            freed.emplace_back(p - memory, size);
+    }
+    // Maps size elements of the file fd from offset (a multiple of the page
+    // size) over the beginning of the memory, copy-on-write; they become the
+    // used memory
+    void map(int fd, std::size_t offset, std::size_t size) {
+        if (size > max)
+            throw std::runtime_error("Memory::map out of memory");
+        if (size && mmap(memory, size * sizeof(T), PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_FIXED, fd, (off_t)offset) ==
+                        MAP_FAILED)
+            throw std::bad_alloc();
+        used = size;
+        high = std::max(high, used);
+        freed.clear();
+    }
     value_type* get_raw_memory() { return memory; }
 };
 
@@ -107,8 +170,10 @@ template <typename T> class Allocator {
         return memory.allocate(mem_size);
     }
 
+    // The arena doesn't reuse the memory: it is only accounted as freed
     void deallocate(value_type* p, std::size_t n) noexcept {
         PRINT("Allocator::deallocate " << n * sizeof *p << " bytes");
+        memory.release(p, n);
     }
 
     [[nodiscard]] std::size_t max_size() const noexcept {
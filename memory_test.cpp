@@ -115,7 +115,7 @@ int main() {
         auto start = std::chrono::system_clock::now();
         int sz = ITERATIONS;
         using namespace microsat;
-        Memory<int> memory{sz * 6};
+        Memory<int> memory((std::size_t)sz * 6);
         {
             std::vector<int, Allocator<int>> v1{Allocator<int>{memory}};
             v1.reserve(sz);
@@ -0,0 +1,71 @@
+//  ----------------------------------------------------------------------------
+//  Main file of the microbenchmarks.                             microbench.cpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#include "bench.hpp"
+#include "tools.hpp"
+#include <fstream>
+#include <iostream>
+
+// -----------------------------------------------------------------------------
+void instructions() {
+    std::cout << "\nUsage: microsat-bench <options>"
+                 "\n\nCases: propagate, analyze, addClause, reduceDB,"
+                 "\n       allocate/..., push_back/... (arena against std),"
+                 "\n       step (interleaved, checked against solve())\n"
+                 "\nOption(s):\n"
+                 "\t-h,--help\tShow this help message\n"
+                 "\t--reps <n>\tTimed repetitions of each case (20)\n"
+                 "\t--warmup <n>\tUntimed repetitions before (3)\n"
+                 "\t--filter <s>\tOnly the cases of which the name contains s\n"
+                 "\t--seed <s>\tSeed of the generated formulas (1)\n"
+                 "\t--json <file>\tWrite the results as JSON to file\n"
+              << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+int run(int argc, char* argv[]) {
+    int reps = 20, warmup = 3;
+    std::string filter, json;
+    unsigned long long seed = 1;
+    for (int i = 1; i < argc; ++i)
+        if (argv[i] == std::string("-h") || argv[i] == std::string("--help")) {
+            instructions();
+            return 0;
+        } else if (argv[i] == std::string("--reps") && i + 1 < argc) {
+            reps = std::atoi(argv[++i]);
+        } else if (argv[i] == std::string("--warmup") && i + 1 < argc) {
+            warmup = std::atoi(argv[++i]);
+        } else if (argv[i] == std::string("--filter") && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (argv[i] == std::string("--seed") && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (argv[i] == std::string("--json") && i + 1 < argc) {
+            json = argv[++i];
+        } else {
+            instructions();
+            throw Fatal("Invalid Parameter: %s\n", argv[i]);
+        }
+    microsat::Bench bench(reps, warmup, filter, seed);
+    bench.run();
+    bench.report(std::cout);
+    if (!json.empty()) {
+        std::ofstream out(json);
+        if (!out)
+            throw Fatal("can't write %s\n", json.c_str());
+        bench.json(out);
+    }
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[]) {
+    try {
+        return run(argc, argv);
+    } catch (Fatal& e) {
+        std::cout << e.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,55 @@
+//  ----------------------------------------------------------------------------
+//  Header file for the solver options.                              options.hpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#ifndef MICROSAT_OPTIONS_HPP
+#define MICROSAT_OPTIONS_HPP
+
+#include <string>
+
+namespace microsat {
+
+// -----------------------------------------------------------------------------
+enum { END = -9, UNKNOWN = -1, UNSAT = 0, SAT = 1, MARK = 2, IMPLIED = 6 };
+// -----------------------------------------------------------------------------
+// Restart policies: switching alternates between focused mode (glucose) and
+// stable mode (reluctant doubling) on a geometric conflict schedule
+enum class Restarts { glucose, luby, geometric, stable, switching };
+// -----------------------------------------------------------------------------
+// Options of the solver set from the command line
+struct Options {
+    Restarts restarts = Restarts::glucose; // The restart policy
+    bool verbose = false;                  // Print a line for each restart
+    int target = 1;            // Decide target phases: 0 never, 1 in stable
+                               // mode, 2 always
+    bool rephase = false;      // Reset the saved phases periodically
+    bool local_search = false; // Only run local search (finds models only)
+    bool xors = true;          // Recognize XORs for Gaussian elimination
+    bool cardinality = false;  // Replace at-most-one cliques of binaries
+    bool symmetry = false;     // Add symmetry-breaking clauses before solving
+    double symmetry_time = 1;  // Seconds of the search for symmetries
+    long long flips = 100000000; // Flips of the local search, which can't
+                                 // prove UNSAT (negative: no limit)
+    bool minimize = true;      // Minimize the lemmas recursively
+    bool fast_paths = true;    // Decide 2-CNF and Horn formulas (and those
+                               // the units decide) without search
+    std::string proof;         // DRAT proof file (empty: no proof)
+    int threads = 0;           // Threads parsing the input (0: every core)
+    std::string dump_snapshot; // Snapshot written after preprocessing
+    std::string load_snapshot; // Snapshot solved instead of the input file
+    std::string checkpoint;    // Snapshot of the search saved periodically
+    double checkpoint_interval = 300; // Seconds between the checkpoints
+    long long models = 0;      // Models to enumerate (0: solve only,
+                               // negative: every model)
+    int chrono = 0;            // Backtrack chronologically when the
+                               // backjump is longer (0: never)
+    std::string trace;         // Chrome trace of the search events (empty:
+                               // none), written on exit and on SIGUSR2
+    long long trace_events = 1 << 20; // Latest events kept for it
+};
+
+} // namespace microsat
+
+#endif // MICROSAT_OPTIONS_HPP
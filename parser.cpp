@@ -0,0 +1,220 @@
+//  ----------------------------------------------------------------------------
+//  Implementation file for the Parser class.                         parser.cpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#include "parser.hpp"
+
+#include "tools.hpp"
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace microsat;
+
+namespace {
+
+// -----------------------------------------------------------------------------
+// Whether c separates tokens
+bool blank(char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+}
+
+// -----------------------------------------------------------------------------
+// Reads the integer at p (before end), advancing p past it
+long long number(const char*& p, const char* end) {
+    bool negative = (*p == '-');
+    if (negative)
+        p++;
+    if (p == end || !std::isdigit((unsigned char)*p))
+        throw Fatal("bad number in the input");
+    long long value = 0;
+    for (; p < end && std::isdigit((unsigned char)*p); p++)
+        if ((value = value * 10 + (*p - '0')) > INT_MAX)
+            throw Fatal("number out of range in the input");
+    if (p < end && !blank(*p))
+        throw Fatal("bad number in the input");
+    return negative ? -value : value;
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// Maps filename, reads its problem line and starts the workers
+Parser::Parser(const std::string& filename, int threads) : filename(filename) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw Fatal("can't open %s", filename.c_str());
+    struct stat info {};
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        size = (std::size_t)info.st_size;
+        map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED)
+            map = nullptr;
+        else
+            madvise(map, size, MADV_SEQUENTIAL);
+    }
+    if (!map) { // A pipe (or an empty file): read it
+        char block[1 << 16];
+        for (ssize_t n; (n = read(fd, block, sizeof(block))) > 0;)
+            copy.append(block, (std::size_t)n);
+        size = copy.size();
+    }
+    close(fd);
+    data = map ? static_cast<const char*>(map) : copy.data();
+    // The chunks end at line boundaries
+    for (std::size_t start = header(); start < size;) {
+        bounds.push_back(start);
+        start = std::min(start + chunk_size, size);
+        const void* eol = memchr(data + start, '\n', size - start);
+        start = eol ? (const char*)eol - data + 1 : size;
+    }
+    bounds.push_back(size);
+    chunks.resize(bounds.size() - 1);
+    if (threads <= 0)
+        threads = (int)std::thread::hardware_concurrency();
+    threads = std::min(threads, (int)chunks.size());
+    if (threads > 1) {
+        window = 2 * (std::size_t)threads;
+        for (int i = 0; i < threads; i++)
+            workers.emplace_back(&Parser::work, this);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Stops the workers and unmaps the file
+Parser::~Parser() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    changed.notify_all();
+    for (auto& worker : workers)
+        worker.join();
+    if (map)
+        munmap(map, size);
+}
+
+// -----------------------------------------------------------------------------
+// Reads the problem line; returns the offset of the line after it
+std::size_t Parser::header() {
+    for (std::size_t start = 0; start < size;) {
+        const void* eol = memchr(data + start, '\n', size - start);
+        std::size_t end = eol ? (const char*)eol - data : size;
+        std::string line(data + start, end - start);
+        start = end + 1;
+        if (line.find_first_not_of(" \t\r") == std::string::npos ||
+            line[0] == 'c')
+            continue;
+        std::size_t pos = line.find("cnf", 0);
+        if (pos == std::string::npos) // cardinality extension
+            pos = line.find("knf", 0);
+        if (line[0] != 'p' || pos == std::string::npos)
+            break;
+        std::istringstream ss(line.substr(pos + 3));
+        if (!(ss >> nVars >> nClauses) || nVars < 0 || nClauses < 0)
+            throw Fatal("can't extract nVars and nClauses!");
+        return std::min(start, size);
+    }
+    throw Fatal("missing problem line in %s", filename.c_str());
+}
+
+// -----------------------------------------------------------------------------
+// Parses chunks until all are claimed
+void Parser::work() {
+    std::unique_lock<std::mutex> guard(lock);
+    for (;;) {
+        changed.wait(guard, [this] {
+            return stopping || claimed == chunks.size() ||
+                   claimed < consumed + window;
+        });
+        if (stopping || claimed == chunks.size())
+            return;
+        std::size_t i = claimed++;
+        guard.unlock();
+        Chunk chunk;
+        try {
+            tokenize(i, chunk.literals);
+        } catch (...) {
+            chunk.error = std::current_exception();
+        }
+        guard.lock();
+        chunks[i] = std::move(chunk);
+        chunks[i].ready = true;
+        changed.notify_all();
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Tokenizes chunk i into out
+void Parser::tokenize(std::size_t i, std::vector<int>& out) const {
+    const char* p = data + bounds[i];
+    const char* end = data + bounds[i + 1];
+    out.reserve((end - p) / 3);
+    while (p < end) {
+        if (blank(*p)) {
+            p++;
+        } else if (*p == 'c') { // A comment up to the end of the line
+            const void* eol = memchr(p, '\n', end - p);
+            const char* stop = eol ? (const char*)eol : end;
+            if (stop - p >= 8 && memcmp(p, "c p show", 8) == 0 &&
+                (stop - p == 8 || blank(p[8]))) {
+                // The projection: the variables shown, up to 0
+                out.push_back(show);
+                for (p += 8; p < stop;) {
+                    if (blank(*p)) {
+                        p++;
+                        continue;
+                    }
+                    long long var = number(p, stop);
+                    if (var < 0 || var > nVars)
+                        throw Fatal("shown variable %lli out of range", var);
+                    if (!var)
+                        break;
+                    out.push_back((int)var);
+                }
+                out.push_back(0);
+            }
+            p = stop;
+        } else if (*p == 'k') { // KNF: the bound, then the literals
+            out.push_back(knf);
+            for (p++; p < end && blank(*p) && *p != '\n'; p++)
+                ;
+            if (p == end || *p == '\n')
+                throw Fatal("bad cardinality constraint in %s",
+                            filename.c_str());
+            out.push_back((int)number(p, end));
+        } else {
+            long long literal = number(p, end);
+            if (std::abs(literal) > nVars)
+                throw Fatal("literal %lli out of range", literal);
+            out.push_back((int)literal);
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// The tokens of the next chunk; nullptr after the last one
+const std::vector<int>* Parser::next() {
+    if (consumed == chunks.size())
+        return nullptr;
+    if (consumed) // The caller is done with the previous chunk
+        std::vector<int>().swap(chunks[consumed - 1].literals);
+    Chunk* chunk = &chunks[consumed];
+    if (workers.empty()) {
+        consumed++;
+        tokenize(consumed - 1, chunk->literals);
+        return &chunk->literals;
+    }
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        changed.wait(guard, [chunk] { return chunk->ready; });
+        consumed++;
+    }
+    changed.notify_all(); // The window moved
+    if (chunk->error)
+        std::rethrow_exception(chunk->error);
+    return &chunk->literals;
+}
@@ -0,0 +1,82 @@
+//  ----------------------------------------------------------------------------
+//  Header file for the Parser class.                                 parser.hpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#ifndef MICROSAT_PARSER_HPP
+#define MICROSAT_PARSER_HPP
+
+#include <climits>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace microsat {
+
+// -----------------------------------------------------------------------------
+// Parses a DIMACS (or KNF) file on several threads. The file is mapped into
+// memory and, after the problem line, split at line boundaries into chunks.
+// Workers tokenize the chunks into buffers of literals while the caller takes
+// the buffers in the order of the file; at most a window of chunks is parsed
+// ahead of the caller. In a buffer every clause ends with 0 (a clause may
+// continue in the next buffer); a "k" line is the knf marker followed by its
+// bound, its literals and 0; a "c p show" line (the projection) is the show
+// marker followed by its variables and 0.
+class Parser {
+  private:
+    const static std::size_t chunk_size = 1 << 22; // Bytes of a chunk
+    struct Chunk {
+        std::vector<int> literals; // The tokens of the chunk
+        std::exception_ptr error;  // The error found while parsing it
+        bool ready = false;        // Parsed, waiting for the caller
+    };
+    std::string filename;
+    const char* data = nullptr;        // The content of the file
+    std::size_t size = 0;              // Its length
+    void* map = nullptr;               // The mapping of the file, if any
+    std::string copy;                  // Or the content read (not mappable)
+    int nVars = 0;                     // The number of variables
+    int nClauses = 0;                  // The number of clauses
+    std::vector<std::size_t> bounds;   // Chunk i is [bounds[i], bounds[i+1])
+    std::vector<Chunk> chunks;         // The chunks in the order of the file
+    std::size_t window = 1;            // Chunks parsed ahead of the caller
+    std::size_t claimed = 0;           // Next chunk to be parsed
+    std::size_t consumed = 0;          // Next chunk for the caller
+    bool stopping = false;             // The workers must return
+    std::mutex lock;                   // Guards the fields above
+    std::condition_variable changed;   // Signals every change of them
+    std::vector<std::thread> workers;  // The threads parsing the chunks
+
+    // Reads the problem line; returns the offset of the line after it
+    std::size_t header();
+    // Parses chunks until all are claimed
+    void work();
+    // Tokenizes chunk i into out
+    void tokenize(std::size_t i, std::vector<int>& out) const;
+
+  public:
+    constexpr static int knf = INT_MIN;      // Marks a "k" line in a buffer
+    constexpr static int show = INT_MIN + 1; // Marks a "c p show" line
+
+    // Maps filename, reads its problem line and starts threads workers
+    // (0: one per core; 1: parse in next())
+    Parser(const std::string& filename, int threads);
+    Parser(const Parser&) = delete;
+    Parser& operator=(const Parser&) = delete;
+    ~Parser();
+
+    // The tokens of the next chunk, valid until the next call; nullptr
+    // after the last one. Rethrows the error found in the chunk.
+    const std::vector<int>* next();
+
+    [[nodiscard]] int getVars() const { return nVars; }
+    [[nodiscard]] int getClauses() const { return nClauses; }
+};
+
+} // namespace microsat
+
+#endif // MICROSAT_PARSER_HPP
@@ -0,0 +1,186 @@
+//  ----------------------------------------------------------------------------
+//  Header file for the solver policies.                            policies.hpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#ifndef MICROSAT_POLICIES_HPP
+#define MICROSAT_POLICIES_HPP
+
+#include "tools.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace microsat {
+
+// -----------------------------------------------------------------------------
+// The strategies of the solver are its template parameters (see BasicSolver):
+// each is a policy class whose functions take the solver S, of which they are
+// friends, and are inlined into the search. A strategy that is switched off
+// is a policy that does nothing, so it costs nothing; the combinations the
+// command line can select are instantiated in solver.cpp.
+// -----------------------------------------------------------------------------
+// Decision heuristic: variable move to front (VMTF)
+// * Siege SAT solver [Ryan’04] used variable move to front (VMTF)
+// * bumped variables moved to head of doubly linked list
+// * search for unassigned variable starts at head
+struct Vmtf {
+    // Moves the variable of literal to the front of the decision list
+    template <class S> static void bump(S& s, int literal) {
+        if (s.false_[literal] != IMPLIED) {
+            // MARK the literal as involved if not a top-level unit
+            s.false_[literal] = MARK;
+            int var = std::abs(literal);
+            // In case var is not already the head of the list
+            if (var != s.head) {
+                s.prev[s.next[var]] = s.prev[var]; // Update the prev link
+                s.next[s.prev[var]] = s.next[var]; // Update the next link
+                s.next[s.head] = var; // Add a next link to the head, and
+                s.prev[var] = s.head; // Make var the new head
+                s.head = var;
+            }
+        }
+    }
+    // The first variable the search for a decision looks at
+    template <class S> static int first(S& s) { return s.head; }
+    // Moves decision to the first unassigned variable from decision on;
+    // returns it (0 if every variable is assigned)
+    template <class S> static int decide(S& s, int& decision) {
+        // As long as the temporary decision is assigned
+        while (s.false_[decision] || s.false_[-decision])
+            // Replace it with the next variable in the decision list
+            decision = s.prev[decision];
+        return decision;
+    }
+};
+
+// -----------------------------------------------------------------------------
+// Restart policy chosen at run time by Options::restarts (the Glucose scheme
+// using exponential moving averages by default)
+struct OptionRestarts {
+    template <class S> static bool restarting(S& s) {
+        switch (s.options.restarts) {
+        case Restarts::switching:
+            // Switching modes always restarts
+            if (s.nConflicts >= s.mode_switch) {
+                s.stable = !s.stable;
+                if (s.trace)
+                    s.trace->record(Trace::mode, s.stable);
+                s.mode_length *= 2; // Both modes get geometrically longer
+                s.mode_switch = s.nConflicts + s.mode_length;
+                s.luby_u = s.luby_v = 1;
+                s.fast = (s.slow / 100) * 125; // Reset the averages as on a
+                return true;                   // restart
+            }
+            if (s.stable)
+                return s.res >= 1024 * std::min(s.luby_v, 1024) && s.luby();
+            [[fallthrough]];
+        case Restarts::glucose:
+            // If fast average is substantially larger than slow average
+            if (s.fast > (s.slow / 100) * 125) {
+                s.fast = (s.slow / 100) * 125; // Update the averages
+                return true;
+            }
+            return false;
+        case Restarts::luby:
+            return s.res >= 100 * s.luby_v && s.luby();
+        case Restarts::geometric:
+            if (s.res < s.interval)
+                return false;
+            s.interval *= 1.5;
+            return true;
+        case Restarts::stable:
+            // Reluctant doubling with a large unit (and a cap on the interval)
+            return s.res >= 1024 * std::min(s.luby_v, 1024) && s.luby();
+        }
+        return false;
+    }
+};
+
+// -----------------------------------------------------------------------------
+// Lemma reduction: a lemma is kept if fewer than k of its literals are
+// satisfied by the model (the saved phases)
+struct SatisfiedReduction {
+    const static int k = 6;
+
+    // Whether the lemma (0 terminated) survives the reduction
+    template <class S> static bool keep(S& s, const int* lemma) {
+        int count = 0;
+        for (; *lemma; lemma++)
+            if ((*lemma > 0) == s.model[std::abs(*lemma)])
+                count++;
+        return count < k;
+    }
+};
+
+// -----------------------------------------------------------------------------
+// Lemma minimization: a literal is left out of the lemma if it is implied by
+// the other literals (recursively through their reasons)
+struct RecursiveMinimize {
+    template <class S> static bool redundant(S& s, int literal) {
+        return s.implied(literal);
+    }
+};
+
+// -----------------------------------------------------------------------------
+// No lemma minimization
+struct NoMinimize {
+    template <class S> static bool redundant(S&, int) { return false; }
+};
+
+// -----------------------------------------------------------------------------
+// No proof tracing
+struct NoProof {
+    void open(const std::string&) {}
+    void add(const int*, int) {}
+    void remove(const int*) {}
+    void conclude() {}
+};
+
+// -----------------------------------------------------------------------------
+// Traces the lemmas (and the deleted ones) in the DRAT format, checkable
+// with drat-trim against the input formula
+class DratProof {
+  private:
+    FILE* out = nullptr; // The proof file
+
+  public:
+    DratProof() = default;
+    DratProof(const DratProof&) = delete;
+    DratProof& operator=(const DratProof&) = delete;
+    ~DratProof() {
+        if (out)
+            fclose(out);
+    }
+
+    // Writes the proof to the file path
+    void open(const std::string& path) {
+        if (!(out = fopen(path.c_str(), "w")))
+            throw Fatal("can't open the proof file %s", path.c_str());
+    }
+    // Adds the lemma *in of size size
+    void add(const int* in, int size) {
+        for (int i = 0; i < size; i++)
+            fprintf(out, "%i ", in[i]);
+        fputs("0\n", out);
+    }
+    // Deletes the lemma (0 terminated)
+    void remove(const int* lemma) {
+        fputs("d ", out);
+        for (; *lemma; lemma++)
+            fprintf(out, "%i ", *lemma);
+        fputs("0\n", out);
+    }
+    // Adds the empty clause: the formula is unsatisfiable
+    void conclude() {
+        fputs("0\n", out);
+        fflush(out);
+    }
+};
+
+} // namespace microsat
+
+#endif // MICROSAT_POLICIES_HPP
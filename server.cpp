@@ -0,0 +1,187 @@
+//  ----------------------------------------------------------------------------
+//  Implementation file for the Server class.                         server.cpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#include "server.hpp"
+
+#include "formula.hpp"
+#include "tools.hpp"
+#include "walker.hpp"
+#include "writer.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace microsat;
+
+// -----------------------------------------------------------------------------
+// Takes a solver from the pool (or creates one) for a new problem
+std::unique_ptr<Solver> Server::acquire(int vars, int clauses) {
+    std::unique_ptr<Solver> solver = nullptr;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (!pool.empty()) {
+            solver = std::move(pool.back());
+            pool.pop_back();
+        }
+    }
+    if (solver)
+        solver->reset(vars, clauses); // Reuse the arena of the warm solver
+    else
+        solver = std::make_unique<Solver>(vars, clauses, options);
+    return solver;
+}
+
+// -----------------------------------------------------------------------------
+// Returns a solver to the pool, unless it already holds a solver for every
+// session that may run (the solver is then freed)
+void Server::release(std::unique_ptr<Solver> solver) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (pool.size() < slots)
+        pool.push_back(std::move(solver));
+}
+
+// -----------------------------------------------------------------------------
+// Serves the requests read from in, answering on out
+void Server::session(FILE* in, FILE* out) {
+    Writer answer(out);
+    std::unique_ptr<Solver> solver = nullptr;
+    Formula formula;    // Copy of the clauses to check the models
+    int limit = budget; // Conflicts per solve
+    bool models = true; // Whether answers include the model
+    std::vector<int> literals;
+    char* data = nullptr;
+    std::size_t capacity = 0;
+    while (getline(&data, &capacity, in) > 0) {
+        char* line = data;
+        while (*line == ' ' || *line == '\t')
+            line++;
+        char kind = *line;
+        if (kind == 'q')
+            break;
+        try {
+            if (kind == '\n' || kind == '\r' || kind == 0 || kind == 'c') {
+                continue;
+            } else if (kind == 'p') { // Start a new problem
+                int vars, clauses;
+                if (sscanf(line, "p cnf %d %d", &vars, &clauses) != 2 ||
+                    vars < 1 || clauses < 0)
+                    throw Fatal("bad problem line");
+                if (solver)
+                    release(std::move(solver));
+                solver = acquire(vars, clauses);
+                formula = Formula(vars);
+                solver->walker = Walker::provider(formula);
+            } else if (kind == 'b') { // Set the conflict budget
+                limit = (int)std::strtol(line + 1, nullptr, 10);
+                if (budget >= 0 && (limit < 0 || limit > budget))
+                    limit = budget; // The server's budget is a maximum
+            } else if (kind == 'm') { // Switch models on or off
+                models = std::strtol(line + 1, nullptr, 10) != 0;
+            } else { // A clause or assumptions terminated by 0
+                if (!solver)
+                    throw Fatal("missing problem line");
+                bool solve = (kind == 'a');
+                char* p = solve ? line + 1 : line;
+                char* end = nullptr;
+                literals.clear();
+                for (;;) {
+                    long literal = std::strtol(p, &end, 10);
+                    if (end == p)
+                        throw Fatal("missing 0 at the end of the line");
+                    p = end;
+                    if (literal == 0)
+                        break;
+                    if (std::labs(literal) > solver->getVars())
+                        throw Fatal("literal %li out of range", literal);
+                    literals.push_back((int)literal);
+                }
+                if (!solve) {
+                    formula.addClause(literals.data(), literals.size());
+                    solver->addInput(literals.data(), literals.size());
+                    continue;
+                }
+                solver->assume(literals.data(), literals.size());
+                int result = solver->solve(limit);
+                solver->assume(nullptr, 0); // Assumptions last for one solve
+                if (result == SAT && formula.check(solver->getModel()) >= 0)
+                    throw Fatal("model check failed");
+                answer.status(result);
+                if (result == SAT && models)
+                    answer.model(solver->getModel(), solver->getVars());
+            }
+        } catch (Fatal& e) {
+            answer.text("e ");
+            answer.text(e.what());
+            answer.text("\n");
+        } catch (std::exception& e) { // The solver may be in any state
+            solver = nullptr;
+            answer.text("e ");
+            answer.text(e.what());
+            answer.text("\n");
+        }
+        answer.flush();
+    }
+    free(data);
+    if (solver)
+        release(std::move(solver));
+}
+
+// -----------------------------------------------------------------------------
+// Accepts sessions on the socket path ("-" for stdin) until killed: each one
+// on its own thread, at most threads at a time (the next connection is
+// accepted when one ends)
+int Server::run(const std::string& path, int threads) {
+    slots = (std::size_t)std::max(threads, 1);
+    if (path == "-") {
+        session(stdin, stdout);
+        return 0;
+    }
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof address.sun_path)
+        throw Fatal("socket path too long: %s", path.c_str());
+    std::strcpy(address.sun_path, path.c_str());
+    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(path.c_str()); // Remove a stale socket of a previous run
+    if (sock < 0 || bind(sock, (sockaddr*)&address, sizeof address) < 0 ||
+        listen(sock, SOMAXCONN) < 0)
+        throw Fatal("can't listen on %s: %s", path.c_str(), strerror(errno));
+    signal(SIGPIPE, SIG_IGN); // A client may go away during an answer
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            ended.wait(guard, [this] { return sessions < slots; });
+        }
+        int fd = accept(sock, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR)
+                continue;
+            throw Fatal("accept failed: %s", strerror(errno));
+        }
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            sessions++;
+        }
+        std::thread([this, fd] {
+            FILE* in = fdopen(fd, "r");
+            FILE* out = fdopen(dup(fd), "w");
+            if (in && out)
+                session(in, out);
+            if (out)
+                fclose(out);
+            if (in)
+                fclose(in);
+            std::lock_guard<std::mutex> guard(lock);
+            sessions--;
+            ended.notify_one();
+        }).detach();
+    }
+}
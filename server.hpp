@@ -0,0 +1,62 @@
+//  ----------------------------------------------------------------------------
+//  Header file for the Server class.                                 server.hpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#ifndef MICROSAT_SERVER_HPP
+#define MICROSAT_SERVER_HPP
+
+#include "solver.hpp"
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace microsat {
+
+// -----------------------------------------------------------------------------
+// A long-lived solver daemon on a Unix domain socket (or on stdin/stdout).
+// Every connection is a session speaking a line-based protocol:
+//     p cnf <vars> <clauses>  start a new problem on a warm solver
+//     <lit> ... 0             add a clause (also after a solve)
+//     a <lit> ... 0           solve under the assumptions ("a 0": none)
+//     b <conflicts>           conflict budget of each solve (-1: none)
+//     m <0|1>                 whether answers include the model
+//     c ...                   comment, ignored
+//     q                       end the session
+// Each solve is answered by "s SATISFIABLE" (and "v" lines),
+// "s UNSATISFIABLE" or "s UNKNOWN"; a malformed request by "e <message>".
+// At most a given number of sessions run at a time, the other clients
+// waiting to be accepted, and as many warm solvers are kept.
+class Server {
+  private:
+    const int budget;      // Default (and maximum) conflicts per solve
+    const Options options; // Options of every solver
+    std::mutex lock;       // Guards pool and sessions
+    std::condition_variable ended; // Signals the end of a session
+    std::vector<std::unique_ptr<Solver>> pool; // Warm solvers of past sessions
+    std::size_t sessions = 0; // Sessions running
+    std::size_t slots = 1;    // Maximum sessions, and solvers in pool
+
+    // Takes a solver from the pool (or creates one) for a new problem
+    std::unique_ptr<Solver> acquire(int vars, int clauses);
+    // Returns a solver to the pool (freeing it if the pool is full)
+    void release(std::unique_ptr<Solver> solver);
+
+  public:
+    explicit Server(int budget = -1, Options options = {})
+        : budget(budget), options(options) {}
+
+    // Serves the requests read from in, answering on out
+    void session(FILE* in, FILE* out);
+    // Accepts sessions on the socket path ("-" for stdin) until killed,
+    // running at most threads of them at a time
+    int run(const std::string& path, int threads = 1);
+};
+
+} // namespace microsat
+
+#endif // MICROSAT_SERVER_HPP
@@ -0,0 +1,99 @@
+//  ----------------------------------------------------------------------------
+//  Implementation file for the vectorized scans.                       simd.cpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#include "simd.hpp"
+#include <utility>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MICROSAT_X86 1
+#include <immintrin.h>
+#endif
+
+using namespace microsat;
+
+namespace {
+
+// -----------------------------------------------------------------------------
+int* scalar(const int* values, int* literals) {
+    for (; *literals; literals++)
+        if (!values[*literals])
+            return literals;
+    return nullptr;
+}
+
+#ifdef MICROSAT_X86
+// -----------------------------------------------------------------------------
+// 8 literals at a time. The loads may read past the terminating 0 (into
+// the arena), but only the literals before it are gathered.
+__attribute__((target("avx2"))) int* avx2(const int* values, int* literals) {
+    const __m256i zero = _mm256_setzero_si256();
+    for (;; literals += 8) {
+        __m256i lits = _mm256_loadu_si256((const __m256i*)literals);
+        unsigned ends = (unsigned)_mm256_movemask_ps(
+            _mm256_castsi256_ps(_mm256_cmpeq_epi32(lits, zero)));
+        // The lanes before the first 0
+        unsigned valid = ends ? (1u << __builtin_ctz(ends)) - 1 : 0xFFu;
+        __m256i mask = _mm256_cmpgt_epi32(
+            _mm256_set1_epi32((int)__builtin_popcount(valid)),
+            _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+        __m256i falses =
+            _mm256_mask_i32gather_epi32(zero, values, lits, mask, 4);
+        unsigned free = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(
+                            _mm256_cmpeq_epi32(falses, zero))) &
+                        valid;
+        if (free)
+            return literals + __builtin_ctz(free);
+        if (ends)
+            return nullptr;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// 16 literals at a time, as above
+__attribute__((target("avx512f"))) int* avx512(const int* values,
+                                               int* literals) {
+    const __m512i zero = _mm512_setzero_si512();
+    for (;; literals += 16) {
+        __m512i lits = _mm512_loadu_si512((const void*)literals);
+        unsigned ends = _mm512_cmpeq_epi32_mask(lits, zero);
+        __mmask16 valid =
+            (__mmask16)(ends ? (1u << __builtin_ctz(ends)) - 1 : 0xFFFFu);
+        __m512i falses =
+            _mm512_mask_i32gather_epi32(zero, valid, lits, values, 4);
+        unsigned free = _mm512_mask_cmpeq_epi32_mask(valid, falses, zero);
+        if (free)
+            return literals + __builtin_ctz(free);
+        if (ends)
+            return nullptr;
+    }
+}
+#endif
+
+// -----------------------------------------------------------------------------
+// The widest scan the CPU supports (the scalar one if !simd) and its name
+std::pair<Scan, const char*> widest(bool simd) {
+#ifdef MICROSAT_X86
+    __builtin_cpu_init();
+    if (simd && __builtin_cpu_supports("avx512f"))
+        return {avx512, "avx512"};
+    if (simd && __builtin_cpu_supports("avx2"))
+        return {avx2, "avx2"};
+#endif
+    return {scalar, "scalar"};
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+Scan microsat::scanNonFalse = widest(true).first;
+
+// -----------------------------------------------------------------------------
+// Selects the widest scan the CPU supports, or the scalar one if !simd
+const char* microsat::selectScan(bool simd) {
+    auto scan = widest(simd);
+    scanNonFalse = scan.first;
+    return scan.second;
+}
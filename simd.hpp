@@ -0,0 +1,28 @@
+//  ----------------------------------------------------------------------------
+//  Header file for the vectorized scans.                               simd.hpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#ifndef MICROSAT_SIMD_HPP
+#define MICROSAT_SIMD_HPP
+
+namespace microsat {
+
+// -----------------------------------------------------------------------------
+// The search of propagate() for a replacement watch in a long clause: the
+// first of the 0-terminated literals that is not false (values[literal] is
+// 0), or nullptr if they all are. The AVX2 and AVX-512 versions gather the
+// values of 8 and 16 literals at once; the version is chosen at run time
+// from the instruction sets of the CPU. (SSE has no gather: without AVX2
+// the scan is scalar.)
+using Scan = int* (*)(const int* values, int* literals);
+extern Scan scanNonFalse;
+
+// Selects the widest scan the CPU supports, or the scalar one if !simd;
+// returns the name of its instruction set
+const char* selectScan(bool simd = true);
+
+} // namespace microsat
+
+#endif // MICROSAT_SIMD_HPP
@@ -0,0 +1,155 @@
+//  ----------------------------------------------------------------------------
+//  Implementation file for the Snapshot class.                     snapshot.cpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#include "snapshot.hpp"
+
+#include "tools.hpp"
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace microsat;
+
+// -----------------------------------------------------------------------------
+// Checksum of size ints at data, continuing from hash: a multiplicative
+// hash of the 64-bit words (and of the last int, if odd)
+std::uint64_t Snapshot::checksum(std::uint64_t hash, const int* data,
+                                 std::size_t size) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+    std::size_t words = size / 2;
+    for (std::size_t i = 0; i < words; i++) {
+        std::uint64_t word;
+        memcpy(&word, bytes + 8 * i, 8);
+        hash = (hash ^ word) * 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 29;
+    }
+    if (size & 1)
+        hash = (hash ^ (std::uint32_t)data[size - 1]) * 0x9E3779B97F4A7C15ull;
+    return hash;
+}
+
+// -----------------------------------------------------------------------------
+// Opens and maps a snapshot, checking its header and checksum
+Snapshot::Snapshot(const std::string& filename) : filename(filename) {
+    fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw Fatal("can't open %s", filename.c_str());
+    struct stat info {};
+    if (fstat(fd, &info) != 0 || (std::size_t)info.st_size < header_size) {
+        close(fd);
+        throw Fatal("%s is not a snapshot", filename.c_str());
+    }
+    size = (std::size_t)info.st_size;
+    map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) {
+        close(fd);
+        throw Fatal("can't map %s", filename.c_str());
+    }
+    memcpy(&header, map, sizeof(header));
+    Header expected;
+    std::size_t ints = (size - header_size) / sizeof(int);
+    if (memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 ||
+        header.version != version || header.used < 0 ||
+        header.literals < 0 || header.cardinalities < 0 ||
+        (std::size_t)header.used + header.literals + header.cardinalities !=
+            ints ||
+        size % sizeof(int) != 0) {
+        release();
+        throw Fatal("%s is not a snapshot (of this version)", filename.c_str());
+    }
+    Header zeroed = header;
+    zeroed.checksum = 0;
+    std::uint64_t hash =
+        checksum(0, reinterpret_cast<const int*>(&zeroed), sizeof(zeroed) / 4);
+    hash = checksum(hash,
+                    reinterpret_cast<const int*>(
+                        static_cast<const char*>(map) + header_size),
+                    ints);
+    if (hash != header.checksum) {
+        release();
+        throw Fatal("%s is corrupted (bad checksum)", filename.c_str());
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Unmaps and closes the file
+Snapshot::~Snapshot() { release(); }
+
+// -----------------------------------------------------------------------------
+// Unmaps and closes the file
+void Snapshot::release() {
+    if (map)
+        munmap(map, size);
+    if (fd >= 0)
+        close(fd);
+    map = nullptr;
+    fd = -1;
+}
+
+// -----------------------------------------------------------------------------
+// Writes the snapshot of header, the arena and formula to filename
+void Snapshot::write(const std::string& filename, Header header,
+                     const int* arena, const Formula& formula) {
+    const std::vector<int>& literals = formula.getLiterals();
+    const std::vector<int>& cardinalities = formula.getCardinalities();
+    header.literals = (std::int64_t)literals.size();
+    header.cardinalities = (std::int64_t)cardinalities.size();
+    header.checksum = 0;
+    std::uint64_t hash =
+        checksum(0, reinterpret_cast<const int*>(&header), sizeof(header) / 4);
+    // The parts are hashed as one sequence of ints: an odd int left over
+    // by a part is paired with the first one of the next
+    int pair[2], odd = 0;
+    auto part = [&](const int* ints, std::size_t size) {
+        if (odd && size) {
+            pair[1] = *(ints++);
+            hash = checksum(hash, pair, 2);
+            odd = 0;
+            size--;
+        }
+        hash = checksum(hash, ints, size & ~std::size_t(1));
+        if (size & 1)
+            pair[odd++] = ints[size - 1];
+    };
+    part(arena, header.used);
+    part(literals.data(), literals.size());
+    part(cardinalities.data(), cardinalities.size());
+    header.checksum = checksum(hash, pair, odd);
+    // Write a temporary file renamed at the end: a checkpoint interrupted
+    // while being written leaves the previous one intact
+    std::string temporary = filename + ".tmp";
+    FILE* out = fopen(temporary.c_str(), "wb");
+    if (!out)
+        throw Fatal("can't write %s", temporary.c_str());
+    std::vector<char> padding(header_size - sizeof(header), 0);
+    bool ok = fwrite(&header, sizeof(header), 1, out) == 1 &&
+              fwrite(padding.data(), 1, padding.size(), out) ==
+                  padding.size() &&
+              fwrite(arena, sizeof(int), header.used, out) ==
+                  (std::size_t)header.used &&
+              fwrite(literals.data(), sizeof(int), literals.size(), out) ==
+                  literals.size() &&
+              fwrite(cardinalities.data(), sizeof(int), cardinalities.size(),
+                     out) == cardinalities.size();
+    if (fclose(out) != 0 || !ok ||
+        std::rename(temporary.c_str(), filename.c_str()) != 0)
+        throw Fatal("can't write %s", filename.c_str());
+}
+
+// -----------------------------------------------------------------------------
+// The input formula
+Formula Snapshot::formula() const {
+    const int* literals = reinterpret_cast<const int*>(
+                              static_cast<const char*>(map) + header_size) +
+                          header.used;
+    const int* cardinalities = literals + header.literals;
+    return Formula(
+        (int)header.vars, (int)header.clauses,
+        std::vector<int>(literals, literals + header.literals),
+        std::vector<int>(cardinalities,
+                         cardinalities + header.cardinalities));
+}
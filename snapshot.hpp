@@ -0,0 +1,106 @@
+//  ----------------------------------------------------------------------------
+//  Header file for the Snapshot class.                             snapshot.hpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#ifndef MICROSAT_SNAPSHOT_HPP
+#define MICROSAT_SNAPSHOT_HPP
+
+#include "formula.hpp"
+#include <cstdint>
+#include <string>
+
+namespace microsat {
+
+// -----------------------------------------------------------------------------
+// A binary image of a solver at the top level, after preprocessing or as a
+// checkpoint of its search: the arena (clauses and lemmas with their
+// watches, top-level assignment, phases, decision order), the state of the
+// search outside it and the input formula to check the models against.
+// Loading maps the arena image straight into the arena of a new solver,
+// copy-on-write. The file is
+//     the header (padded to header_size bytes)
+//     the arena: used ints
+//     the formula: literals ints, then cardinalities ints
+// and the checksum covers all of it (with the checksum field 0).
+class Snapshot {
+  public:
+    const static std::uint32_t version = 3;
+    const static std::size_t header_size = 1 << 16; // A multiple of the
+                                                    // page size
+    // The state of the solver outside the arena
+    struct Header {
+        char magic[8] = {'M', 'S', 'A', 'T', 'S', 'N', 'A', 'P'};
+        std::uint32_t version = Snapshot::version;
+        std::uint32_t ref_size = 0;  // Ints of a clause reference
+        std::int64_t vars = 0;       // The number of variables
+        std::int64_t clauses = 0;    // The number of clauses
+        std::int64_t used = 0;       // Ints of the arena
+        std::int64_t fixed = 0;      // End of the input clauses in the arena
+        std::int64_t forced = 0;     // The stack pointers, as offsets from
+        std::int64_t processed = 0;  // the bottom of the stack
+        std::int64_t assigned = 0;   //
+        std::int64_t head = 0;       // The head of the decision list
+        std::int64_t inconsistent = 0; // The formula is unsatisfiable
+        std::int64_t xors = 0;       // Gaussian elimination was attached
+        // The search (see BasicSolver)
+        std::int64_t lemmas = 0;
+        std::int64_t conflicts = 0;
+        std::int64_t max_lemmas = 0;
+        std::int64_t fast = 0;
+        std::int64_t slow = 0;
+        std::int64_t stable = 0;
+        std::int64_t luby_u = 0;
+        std::int64_t luby_v = 0;
+        double interval = 0;
+        std::int64_t mode_length = 0;
+        std::int64_t mode_switch = 0;
+        std::int64_t target_size = 0;
+        std::int64_t best_size = 0;
+        std::int64_t rephased = 0;
+        std::int64_t rephase_next = 0;
+        std::uint64_t seed = 0;
+        // The formula
+        std::int64_t literals = 0;   // Ints of the clauses of the formula
+        std::int64_t cardinalities = 0; // Ints of its constraints
+        std::uint64_t checksum = 0;
+    };
+
+  private:
+    std::string filename;
+    int fd = -1;                // The open file
+    void* map = nullptr;        // Its mapping (read only)
+    std::size_t size = 0;       // Its length
+    Header header;
+
+    // Unmaps and closes the file
+    void release();
+    // Checksum of size ints at data, continuing from hash
+    static std::uint64_t checksum(std::uint64_t hash, const int* data,
+                                  std::size_t size);
+
+  public:
+    // Opens and maps a snapshot, checking its header and checksum
+    explicit Snapshot(const std::string& filename);
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+    ~Snapshot();
+
+    // Writes the snapshot of header (without the checksum), the arena
+    // and formula to filename; a previous snapshot there is replaced only
+    // once the new one is complete
+    static void write(const std::string& filename, Header header,
+                      const int* arena, const Formula& formula);
+
+    // The input formula
+    [[nodiscard]] Formula formula() const;
+
+    [[nodiscard]] const Header& getHeader() const { return header; }
+    // The open file, of which the arena starts at header_size
+    [[nodiscard]] int getFile() const { return fd; }
+};
+
+} // namespace microsat
+
+#endif // MICROSAT_SNAPSHOT_HPP
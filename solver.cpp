@@ -6,38 +6,96 @@
 // -----------------------------------------------------------------------------
 
 #include "solver.hpp"
+#include "simd.hpp"
+#include "snapshot.hpp"
 #include "tools.hpp"
+#include <cassert>
 
 using namespace microsat;
 
 // -----------------------------------------------------------------------------
 // Default constructor that initializes the data structures
-Solver::Solver(int n, int m) : nVars(n), nClauses(m), mem(mem_max) {
+template <class H, class R, class D, class M, class P>
+BasicSolver<H, R, D, M, P>::BasicSolver(int n, int m, Options options)
+    : nVars(n), nClauses(m), options(options), mem(mem_max) {
+    reset(n, m);
+    proof.open(options.proof);
+}
+
+// -----------------------------------------------------------------------------
+// Reinitializes the solver for a new formula reusing the same arena
+template <class H, class R, class D, class M, class P>
+void BasicSolver<H, R, D, M, P>::reset(int n, int m) {
+    nVars = n;
+    nClauses = m;
+    nLemmas = 0;
+    nConflicts = 0;
+    maxLemmas = 2000;
+    fast = slow = ave_max;
+    stable = (options.restarts == Restarts::stable);
+    luby_u = luby_v = 1;
+    interval = 100;
+    mode_length = mode_switch = 1000;
+    target_size = best_size = 0;
+    rephased = 0;
+    rephase_next = 1000;
+    seed = 1;
+    mem_fixed = 0;
+    res = 0;
+    inconsistent = false;
+    assumptions.clear();
+    blocking.clear();
+    gauss = nullptr;
+    cards = nullptr;
+    // Everything is carved out of the arena again from its start
+    mem.resize(0);
     db = mem.get_raw_memory();
+    v_model = decltype(v_model){Allocator<int>{mem}};
+    v_next = decltype(v_next){Allocator<int>{mem}};
+    v_prev = decltype(v_prev){Allocator<int>{mem}};
+    v_buffer = decltype(v_buffer){Allocator<int>{mem}};
+    v_false_stack = decltype(v_false_stack){Allocator<int>{mem}};
+    v_target = decltype(v_target){Allocator<int>{mem}};
+    v_best = decltype(v_best){Allocator<int>{mem}};
     v_model.reserve(n + 1);       // Full assignment of the variables
     v_next.reserve(n + 1);        // Next variable in the heuristic order
     v_prev.reserve(n + 1);        // Previous variable in the heuristic order
     v_buffer.reserve(n);          // A buffer to store a temporary clause
-    v_reason.reserve(n + 1);      // Array of clauses
+    reason = allocateRefs(n + 1); // Array of clauses
     v_false_stack.reserve(n + 1); // Stack of falsified literals
+    v_target.reserve(n + 1);      // Target phases
+    v_best.reserve(n + 1);        // Best phases
 
     model = v_model.data();
     next = v_next.data();
     prev = v_prev.data();
     buffer = v_buffer.data();
-    reason = v_reason.data();
     false_stack = v_false_stack.data();
+    target = v_target.data();
+    best = v_best.data();
 
     forced = false_stack;    // Points inside *falseStack at first decision
     processed = false_stack; // Points inside *falseStack at first unprocessed
     assigned = false_stack;  // Points inside *falseStack at last unprocessed
+    xor_processed = false_stack;
+    card_processed = false_stack;
 
     // Labels for variables, non-zero means false
     false_ = mem.allocate(2 * n + 1) + n; // having both polarity
     // Offset of the first watched clause
-    first = mem.allocate(2 * n + 1) + n; // having both polarity
+    first = allocateRefs(2 * n + 1) + n; // having both polarity
+    level = mem.allocate(n + 1); // Decision levels
+    decisions = 0;
     // Make sure there is a 0 before the clauses are loaded.
     *mem.allocate(1) = 0;
+    mem_vars = mem_used();
+
+    // The arena may hold a previous formula: clear the sentinels and stack
+    std::fill(false_stack, false_stack + n + 1, 0);
+    std::fill(reason, reason + n + 1, 0);
+    model[0] = prev[0] = next[n] = 0;
+    false_[0] = level[0] = 0;
+    first[0] = END;
 
     // Initialize the main data structures:
     for (int i = 1; i <= n; i++) { // for each variable
@@ -46,27 +104,114 @@ Solver::Solver(int n, int m) : nVars(n), nClauses(m), mem(mem_max) {
         next[i - 1] = i; // the double-linked list for variable-move-to-front,
         // phase selection: assign variable to which phase (true or false)?
         model[i] = 0;               // the model (phase-saving)
+        target[i] = best[i] = 0;    // the target and best phases,
         false_[-i] = false_[i] = 0; // the false array,
+        level[i] = 0;               // the levels,
         first[i] = first[-i] = END; // and first (watch pointers).
     }
     // decision heuristics
     head = n; // Initialize the head of the double-linked list
 }
 
+// -----------------------------------------------------------------------------
+// Writes the arena and the state of the search to the snapshot path,
+// restarting first. Everything else is either rebuilt by reset() or attached
+// again by the caller.
+template <class H, class R, class D, class M, class P>
+void BasicSolver<H, R, D, M, P>::dump(const std::string& path,
+                                      const Formula& formula) {
+    if (searching())
+        restart();
+    Snapshot::Header header;
+    header.ref_size = ref_size;
+    header.vars = nVars;
+    header.clauses = nClauses;
+    header.used = mem_used();
+    header.fixed = mem_fixed;
+    header.forced = forced - false_stack;
+    header.processed = processed - false_stack;
+    header.assigned = assigned - false_stack;
+    header.head = head;
+    header.inconsistent = inconsistent;
+    header.xors = (gauss != nullptr);
+    header.lemmas = nLemmas;
+    header.conflicts = nConflicts;
+    header.max_lemmas = maxLemmas;
+    header.fast = fast;
+    header.slow = slow;
+    header.stable = stable;
+    header.luby_u = luby_u;
+    header.luby_v = luby_v;
+    header.interval = interval;
+    header.mode_length = mode_length;
+    header.mode_switch = mode_switch;
+    header.target_size = target_size;
+    header.best_size = best_size;
+    header.rephased = rephased;
+    header.rephase_next = rephase_next;
+    header.seed = seed;
+    Snapshot::write(path, header, db, formula);
+}
+
+// -----------------------------------------------------------------------------
+// Reinitializes the solver with the arena of snapshot. reset() lays out the
+// arena as it was for the same number of variables, so the pointers into it
+// stay valid once the image is mapped over it.
+template <class H, class R, class D, class M, class P>
+void BasicSolver<H, R, D, M, P>::load(const Snapshot& snapshot) {
+    const Snapshot::Header& header = snapshot.getHeader();
+    if (header.ref_size != ref_size)
+        throw Fatal("the snapshot was written with %i-int references",
+                    (int)header.ref_size);
+    reset((int)header.vars, (int)header.clauses);
+    if ((std::size_t)header.used < mem.mem_used() || header.forced < 0 ||
+        header.forced > header.processed ||
+        header.processed > header.assigned || header.assigned > nVars ||
+        header.head < 0 || header.head > nVars)
+        throw Fatal("the snapshot is inconsistent");
+    mem.map(snapshot.getFile(), Snapshot::header_size,
+            (std::size_t)header.used);
+    mem_fixed = (Ref)header.fixed;
+    forced = false_stack + header.forced;
+    processed = false_stack + header.processed;
+    assigned = false_stack + header.assigned;
+    head = (int)header.head;
+    inconsistent = header.inconsistent != 0;
+    nLemmas = (int)header.lemmas;
+    nConflicts = (int)header.conflicts;
+    maxLemmas = (int)header.max_lemmas;
+    fast = (int)header.fast;
+    slow = (int)header.slow;
+    stable = header.stable != 0;
+    luby_u = (int)header.luby_u;
+    luby_v = (int)header.luby_v;
+    interval = header.interval;
+    mode_length = (int)header.mode_length;
+    mode_switch = (int)header.mode_switch;
+    target_size = (int)header.target_size;
+    best_size = (int)header.best_size;
+    rephased = (int)header.rephased;
+    rephase_next = (int)header.rephase_next;
+    seed = header.seed;
+}
+
 // -----------------------------------------------------------------------------
 // Adds a clause stored in *in of size size
-int* Solver::addClause(int* in, int size, int irr) {
-    // Store a pointer to the beginning of the clause
-    int clause_head = mem_used();
+template <class H, class R, class D, class M, class P>
+int* BasicSolver<H, R, D, M, P>::addClause(int* in, int size, int irr) {
+    // Store a pointer to the beginning of the clause (aligned for the links)
+    Ref clause_head = align(mem_used());
+    if (ref_size > 1)
+        mem.resize(clause_head);
     // Allocate memory for the clause in the database
-    int* clause = mem.allocate(size + 2 + 1);
+    int* clause = mem.allocate(size + 2 * ref_size + 1);
     // shift the head of the clause because the first two for watch pointers
-    clause += 2;
+    clause += 2 * ref_size;
     // If the clause is not unit, then add two watch pointers to the data
     // structure
     if (size > 1) { // first two literal are watched
-        addWatch(in[0], clause_head);
-        addWatch(in[1], clause_head + 1);
+        addWatch(in[0], watchOf(clause_head, 0));
+        addWatch(in[1], watchOf(clause_head, 1));
     }
     // Copy the clause from the buffer to the database
     std::copy(in, in + size, clause);
@@ -80,74 +225,127 @@ int* Solver::addClause(int* in, int size, int irr) {
     return clause;
 }
 
+// -----------------------------------------------------------------------------
+// Adds an input clause at the top level (backtracking if needed)
+template <class H, class R, class D, class M, class P>
+int BasicSolver<H, R, D, M, P>::addInput(int* in, int size) {
+    if (inconsistent)
+        return UNSAT;
+    // Undo the decisions of a previous solve()
+    if (searching())
+        restart();
+    // Move the literals that are not false to the front to watch them
+    int free = 0, satisfied = 0;
+    for (int i = 0; i < size; i++)
+        if (!false_[in[i]]) {
+            if (false_[-in[i]])
+                satisfied = 1;
+            std::swap(in[free++], in[i]);
+        }
+    // All literals false at the top level: the formula is unsatisfiable
+    if (!free) {
+        inconsistent = true;
+        proof.conclude();
+        return UNSAT;
+    }
+    int* clause = addClause(in, size, 1);
+    // Directly assign new units (forced = 1)
+    if (free == 1 && !satisfied)
+        assign(clause, 1);
+    return SAT;
+}
+
+// -----------------------------------------------------------------------------
+// Propagates the top-level units
+template <class H, class R, class D, class M, class P>
+int BasicSolver<H, R, D, M, P>::simplify() {
+    if (inconsistent)
+        return UNSAT;
+    // Undo the decisions of a previous solve()
+    if (searching())
+        restart();
+    if (propagate() == UNSAT) {
+        inconsistent = true;
+        proof.conclude();
+        return UNSAT;
+    }
+    return SAT;
+}
+
+// -----------------------------------------------------------------------------
+// Sets the assumptions (literals) for the next call of solve()
+template <class H, class R, class D, class M, class P>
+void BasicSolver<H, R, D, M, P>::assume(const int* in, int size) {
+    assumptions.assign(in, in + size);
+}
+
 // -----------------------------------------------------------------------------
 // Adds a watch pointer to a clause containing lit
-void Solver::addWatch(int literal, int mem) {
-    db[mem] = first[literal]; // By updating the database and the pointers
-    first[literal] = mem;
+template <class H, class R, class D, class M, class P>
+void BasicSolver<H, R, D, M, P>::addWatch(int literal, Ref watch) {
+    link(watch) = first[literal]; // By updating the database and the pointers
+    first[literal] = watch;
 }
 
 // -----------------------------------------------------------------------------
 // Unassign the literal
-void Solver::unassign(int lit) { false_[lit] = 0; }
+template <class H, class R, class D, class M, class P>
+void BasicSolver<H, R, D, M, P>::unassign(int lit) { false_[lit] = 0; }
 
 // -----------------------------------------------------------------------------
 // Perform a restart (i.e., unassign all variables)
-void Solver::restart() {
-    // Remove all unforced false literals from falseStack
-    while (assigned > forced)
-        unassign(*(--assigned));
+template <class H, class R, class D, class M, class P>
+void BasicSolver<H, R, D, M, P>::restart() {
+    // Remove all unforced false literals from falseStack (but the top-level
+    // ones assigned out of order)
+    if (options.chrono)
+        backtrack(0);
+    else
+        while (assigned > forced)
+            unassign(*(--assigned));
     // Reset the processed pointer
     processed = forced;
+    xor_processed = std::min(xor_processed, assigned);
+    uncount();
+    // The remaining literals are forced: their reasons are never asked for
+    if (cards)
+        cards->clearReasons();
 }
 
 // -----------------------------------------------------------------------------
 // Make the first literal of the reason true
-void Solver::assign(const int* reason_, int forced_) {
+template <class H, class R, class D, class M, class P>
+void BasicSolver<H, R, D, M, P>::assign(const int* reason_, int forced_) {
     // Let lit be the first literal in the reason
     int lit = reason_[0];
+    // Backtracking chronologically, its level is the highest of the others
+    if (options.chrono) {
+        int highest = 0;
+        for (const int* p = reason_ + 1; *p; p++)
+            highest = std::max(highest, level[std::abs(*p)]);
+        level[std::abs(lit)] = highest;
+        forced_ = (highest == 0);
+    }
     // Mark lit as true and IMPLIED if forced
     false_[-lit] = forced_ ? IMPLIED : 1;
     // Push it on the assignment stack
     *(assigned++) = -lit;
     // Set the reason clause of lit
-    reason[std::abs(lit)] = 1 + (int)((reason_)-db);
+    reason[std::abs(lit)] = 1 + (Ref)((reason_)-db);
     // Mark the literal as true in the model
     model[std::abs(lit)] = (lit > 0);
 }
 
-// -----------------------------------------------------------------------------
-// Move the variable to the front of the decision list
-// bump variables occurring in learned clauses (strategy is to bump all
-// variables used to derive learned clause)
-// * Siege SAT solver [Ryan’04] used variable move to front (VMTF)
-// * bumped variables moved to head of doubly linked list
-// * search for unassigned variable starts at head
-void Solver::bump(int literal) {
-    if (false_[literal] != IMPLIED) {
-        // MARK the literal as involved if not a top-level unit
-        false_[literal] = MARK;
-        int var = std::abs(literal);
-        // In case var is not already the head of the list
-        if (var != head) {
-            prev[next[var]] = prev[var]; // Update the prev link, and
-            next[prev[var]] = next[var]; // Update the next link, and
-            next[head] = var;            // Add a next link to the head, and
-            prev[var] = head;            // Make var the new head
-            head = var;
-        }
-    }
-}
-
 // -----------------------------------------------------------------------------
 // Check if literal is implied by MARK literals
-int Solver::implied(int literal) {
+template <class H, class R, class D, class M, class P>
+int BasicSolver<H, R, D, M, P>::implied(int literal) {
     // If checked before return old result
     if (false_[literal] > MARK)
         return (false_[literal] & MARK);
     if (!reason[std::abs(literal)])
         return 0; // In case literal is a decision, it is not implied
-    int* p = (db + reason[std::abs(literal)] - 1); // Get the reason of literal
+    int* p = (db + explain(std::abs(literal)) - 1); // Get the reason of literal
     // While there are literals in the reason, recursively check if non-MARK
     // literals are implied
     while (*(++p))
@@ -162,49 +360,115 @@ int Solver::implied(int literal) {
 // -----------------------------------------------------------------------------
 // Removes "less useful" lemmas from DB
     // Remove strategy
-void Solver::reduceDB(int k) {
+template <class H, class R, class D, class M, class P>
+void BasicSolver<H, R, D, M, P>::reduceDB() {
     // Allow more lemmas in the future
     while (nLemmas > maxLemmas)
         maxLemmas += 300;
     // Reset the number of lemmas
+    int lemmas = nLemmas;
     nLemmas = 0;
     // Loop over the variables
     for (int i = -nVars; i <= nVars; i++) {
         if (i == 0)
             continue;
         // Get the pointer to the first watched clause
-        int* watch = &first[i];
-        while (*watch != END)       // As long as there are watched clauses
-            if (*watch < mem_fixed) // Remove the watch if it points to a lemma
-                watch = (db + *watch);
-            else // Otherwise (meaning an input clause) go to next watch
-                *watch = db[*watch];
+        Ref* watch = &first[i];
+        while (*watch != END)    // As long as there are watched clauses
+            if (input(*watch))   // Keep the watch of an input clause
+                watch = &link(*watch);
+            else // Otherwise (meaning a lemma) remove the watch
+                *watch = link(*watch);
     }
     // Virtually remove all lemmas
-    int old_used = mem_used();
+    Ref old_used = mem_used(), old_fixed = mem_fixed;
     mem.resize(mem_fixed);
-    // While the old memory contains lemmas
-    for (int i = mem_fixed + 2; i < old_used; i += 3) {
+    // The blocking clauses go first, as input clauses: then the lemmas are
+    // read from a copy, as the blocking clauses may overwrite them
+    std::vector<int> copy;
+    if (!blocking.empty())
+        copy.assign(db + old_fixed, db + old_used);
+    auto old = [&](Ref i) {
+        return copy.empty() ? db + i : copy.data() + (i - old_fixed);
+    };
+    for (Ref head_ : blocking) {
+        int size = 0;
+        for (int* clause = old(head_); *clause; clause++)
+            buffer[size++] = *clause;
+        addInput(buffer, size); // Watching literals not false (or UNSAT)
+    }
+    auto next_blocking = blocking.begin();
+    // While the old memory contains lemmas (skipping the 0, the padding and
+    // the links to the next one)
+    for (Ref i = align(old_fixed) + 2 * ref_size; i < old_used;
+         i = align(i + 1) + 2 * ref_size) {
         // Get the lemma to which the head is pointing
-        int count = 0, head_ = i;
-        // Count the number of literals
-        while (db[i]) {
-            int literal = db[i++];
-            // That are satisfied by the current model
-            if ((literal > 0) == model[std::abs(literal)])
-                count++;
+        Ref head_ = i;
+        // Find its end
+        while (*old(i))
+            i++;
+        if (next_blocking != blocking.end() && *next_blocking == head_) {
+            next_blocking++; // Added above
+            continue;
         }
-        // If the latter is smaller than k, add it back
-        if (count < k) {
-            auto ref = db + head_;
-            addClause(ref, i - head, 0); // ToDo addClause
+        // Add it back if the policy keeps it (the kept lemmas only move
+        // down, the others are still intact)
+        if (D::keep(*this, old(head_))) {
+            auto ref = old(head_);
+            addClause(ref, i - head_, 0); // ToDo addClause
+        } else {
+            proof.remove(old(head_));
         }
     }
+    blocking.clear();
+    if (trace)
+        trace->record(Trace::reduce, lemmas, nLemmas, maxLemmas);
+    if (options.verbose)
+        printf("c reduced the arena from %lli to %lli ints (high-water "
+               "%lli)\n",
+               (long long)old_used, (long long)mem_used(),
+               (long long)mem.mem_high());
+}
+
+// -----------------------------------------------------------------------------
+// Accounts the arena: the per-variable arrays (with the heads of the watch
+// lists) come first, then the clauses, each after its links
+template <class H, class R, class D, class M, class P>
+typename BasicSolver<H, R, D, M, P>::Usage BasicSolver<H, R, D, M, P>::usage() {
+    Usage usage;
+    std::size_t heads = (2 * (std::size_t)nVars + 1) * ref_size;
+    // The vectors of the per-variable arrays may have been carved again
+    // (after a reset): only what they released below mem_vars is theirs
+    std::size_t released = mem.mem_freed(0, mem_vars);
+    usage.variables = mem_vars - heads - released;
+    usage.watches = heads;
+    Ref used = mem_used(), end = mem_vars; // End of the previous clause
+    for (Ref i = align(mem_vars) + 2 * ref_size; i < used;
+         i = align(i + 1) + 2 * ref_size) {
+        Ref head_ = i;
+        while (db[i])
+            i++;
+        usage.waste += head_ - 2 * ref_size - end; // Padding before it
+        usage.watches += 2 * ref_size;
+        (head_ < mem_fixed ? usage.input : usage.lemmas) += i + 1 - head_;
+        end = i + 1;
+    }
+    usage.waste += released; // In the per-variable arrays
+    usage.high = mem.mem_high();
+    usage.garbage = usage.high - used;
+    // The categories cover the used part
+    assert(usage.variables + usage.input + usage.lemmas + usage.watches +
+               usage.waste ==
+           (std::size_t)used);
+    return usage;
 }
 
 // -----------------------------------------------------------------------------
 // Compute a resolvent from falsified clause
-int* Solver::analyze(int* clause) {
+template <class H, class R, class D, class M, class P>
+int* BasicSolver<H, R, D, M, P>::analyze(int* clause) {
+    // Remember the phases of the stack below the conflict level
+    savePhases();
     // Bump restarts and update the statistic
     res++;
     nConflicts++;
@@ -223,7 +487,7 @@ int* Solver::analyze(int* clause) {
                 if (!reason[std::abs(*check)])
                     goto build;
             // Get the reason and ignore first literal
-            clause = db + reason[std::abs(*assigned)];
+            clause = db + explain(std::abs(*assigned));
             // MARK all literals in reason
             while (*clause)
                 bump(*(clause++)); // ToDo bump
@@ -237,12 +501,13 @@ build:;
     int size = 0;
     int lbd = 0; // Literal Block Distance (LBD) of Glucose
     int flag = 0;
+    int levels = 0, jump = 0; // Decisions walked, and those undone
     // Loop from tail to front
     int* p = processed = assigned;
     // Only literals on the stack can be MARKed
     while (p >= forced) {
         // If MARKed and not implied
-        if ((false_[*p] == MARK) && !implied(*p)) { // ToDo implied
+        if ((false_[*p] == MARK) && !M::redundant(*this, *p)) {
             // Add literal to conflict clause buffer
             buffer[size++] = *p;
             flag = 1;
@@ -251,9 +516,12 @@ build:;
         if (!reason[std::abs(*p)]) {
             lbd += flag;
             flag = 0;
+            levels++;
             // And update the processed pointer
-            if (size == 1)
+            if (size == 1) {
                 processed = p;
+                jump = levels;
+            }
         }
         // Reset the MARK flag for all variables on the stack
         false_[*(p--)] = 1;
@@ -269,6 +537,8 @@ build:;
     // Update the slow moving average
     slow -= slow >> 15;
     slow += lbd << 5;
+    if (trace)
+        trace->record(Trace::conflict, lbd, size, jump);
 
     // Loop over all unprocessed literals
     while (assigned > processed)
@@ -276,53 +546,189 @@ build:;
         unassign(*(assigned--)); // ToDo unassign
     // Assigned now equal to processed
     unassign(*assigned); // ToDo unassign
+    xor_processed = std::min(xor_processed, assigned);
+    uncount();
     // Terminate the buffer (and potentially print clause)s
     buffer[size] = 0;
     // Add new conflict clause to redundant db
+    proof.add(buffer, size);
+    if (learned)
+        learned(buffer, size);
     return addClause(buffer, size, 0); // ToDo addClause
 }
 
+// -----------------------------------------------------------------------------
+// Unassigns the literals above level target, keeping the lower ones
+template <class H, class R, class D, class M, class P>
+void BasicSolver<H, R, D, M, P>::backtrack(int target) {
+    if (decisions <= target)
+        return;
+    // The decision of level target + 1: below it, the levels are <= target
+    int* start = assigned;
+    do
+        start--;
+    while (reason[std::abs(*start)] || level[std::abs(*start)] != target + 1);
+    // Unassign the literals of higher levels, moving the others down (in
+    // their order, so that the reasons stay below the literals)
+    int* kept = start;
+    for (int* p = start; p < assigned; p++)
+        if (level[std::abs(*p)] > target)
+            unassign(*p);
+        else
+            *(kept++) = *p;
+    assigned = kept;
+    // The kept literals are propagated again: a clause they watch may have
+    // lost its true literal
+    processed = std::min(processed, start);
+    decisions = target;
+}
+
+// -----------------------------------------------------------------------------
+// Learns the first-UIP lemma of clause at conflict_level, the current level.
+// The literals above the last decision may be of lower levels: the
+// resolution only counts the literals of the conflict level.
+template <class H, class R, class D, class M, class P>
+int* BasicSolver<H, R, D, M, P>::analyzeChrono(int* clause,
+                                               int conflict_level) {
+    savePhases();
+    res++;
+    nConflicts++;
+    // MARK the literals (the top-level ones aren't), counting those of the
+    // conflict level that are not resolved yet
+    int open = 0;
+    auto mark = [&](int literal) {
+        if (false_[literal] == 1 && level[std::abs(literal)] == conflict_level)
+            open++;
+        bump(literal);
+    };
+    while (*clause)
+        mark(*(clause++));
+    // Resolve on the MARK literals of the conflict level from the top of the
+    // stack until one is left: the first UIP
+    int uip = 0;
+    for (int* p = assigned - 1;; p--) {
+        if (false_[*p] != MARK || level[std::abs(*p)] != conflict_level)
+            continue;
+        if (--open == 0) {
+            uip = *p;
+            break;
+        }
+        false_[*p] = 1; // Resolved: not in the lemma
+        for (clause = db + explain(std::abs(*p)); *clause; clause++)
+            mark(*clause);
+    }
+    // Build the lemma: the UIP and the MARK literals of lower levels that
+    // are not implied by the others, unmarking the stack
+    int size = 0;
+    buffer[size++] = uip;
+    lemma_levels.clear();
+    for (int* p = assigned - 1; p >= forced; p--) {
+        int var = std::abs(*p);
+        if (false_[*p] == MARK && *p != uip && !M::redundant(*this, *p)) {
+            buffer[size++] = *p;
+            lemma_levels.push_back(level[var]);
+        }
+        false_[*p] = level[var] ? 1 : IMPLIED;
+    }
+    // The highest of the lower levels is watched with the UIP: the lemma
+    // asserts the UIP at it
+    for (int i = 2; i < size; i++)
+        if (level[std::abs(buffer[i])] > level[std::abs(buffer[1])])
+            std::swap(buffer[1], buffer[i]);
+    // LBD: the number of levels of the lemma
+    std::sort(lemma_levels.begin(), lemma_levels.end());
+    int lbd = 1 + (int)(std::unique(lemma_levels.begin(), lemma_levels.end()) -
+                        lemma_levels.begin());
+    // Update the moving averages (see analyze())
+    fast -= fast >> 5;
+    fast += lbd << 15;
+    slow -= slow >> 15;
+    slow += lbd << 5;
+    if (trace) // The backjump the lemma asks for (maybe not taken)
+        trace->record(Trace::conflict, lbd, size,
+                      conflict_level -
+                          (size > 1 ? level[std::abs(buffer[1])] : 0));
+    buffer[size] = 0;
+    proof.add(buffer, size);
+    if (learned)
+        learned(buffer, size);
+    return addClause(buffer, size, 0);
+}
+
+// -----------------------------------------------------------------------------
+// Handles a conflict on clause with chronological backtracking
+template <class H, class R, class D, class M, class P>
+int BasicSolver<H, R, D, M, P>::chronological(int* clause) {
+    // The conflict level: the highest of the clause, possibly below the
+    // current one
+    int conflict_level = 0;
+    for (int* p = clause; *p; p++)
+        conflict_level = std::max(conflict_level, level[std::abs(*p)]);
+    if (conflict_level == 0)
+        return UNSAT;
+    backtrack(conflict_level);
+    int* lemma = analyzeChrono(clause, conflict_level);
+    int jump = lemma[1] ? level[std::abs(lemma[1])] : 0;
+    // A long backjump throws away levels that would mostly be rebuilt:
+    // backtrack one level only, asserting the UIP out of order
+    backtrack(conflict_level - jump > options.chrono ? conflict_level - 1
+                                                      : jump);
+    assign(lemma, 0); // At level jump
+    return SAT;
+}
+
 // -----------------------------------------------------------------------------
 // Performs unit propagation
-int Solver::propagate() {
-    // Initialize forced flag
-    int forced_ = reason[std::abs(*processed)];
+template <class H, class R, class D, class M, class P>
+int BasicSolver<H, R, D, M, P>::propagate() {
+    // Initialize forced flag (the slot at processed is stale if empty:
+    // then the literals are forced iff there is no decision on the stack)
+    int forced_ = options.chrono          ? decisions == 0
+                  : processed < assigned ? reason[std::abs(*processed)] != 0
+                                         : forced == assigned;
+// Propagate on the clauses
+clauses:
     // While unprocessed false literals
     while (processed < assigned) {
         // Get first unprocessed literal
         int lit = *(processed++);
         // Obtain the first watch pointer
-        int* watch = &first[lit];
+        Ref* watch = &first[lit];
         // While there are watched clauses (watched by lit)
         while (*watch != END) { // while (*watch != -9)
             // Let's assume that the clause is unit
             bool unit = true;
             // Get the clause from db
-            int* clause = (db + *watch + 1); // it might be the first or second
-            // Set the pointer to the first literal in the clause
-            // if this is the second watch literal, then forward the pointer...
-            if (clause[-2] == 0) // all clauses ends with a 0... even there is
-                clause++;        // a zero before the first clause....
+            int* clause = literals(*watch);
             // Ensure that the other watched literal is in front
             if (clause[0] == lit)
                 clause[0] = clause[1];
-            // Scan the non-watched literals
-            for (int i = 2; unit && clause[i]; i++)
-                // When clause[i] is not false, it is either true or unset
+            // Scan the non-watched literals for one that is not false (it
+            // is either true or unset): the first few one at a time, the
+            // rest of a long clause vectorized (simd.hpp)
+            int* other = nullptr;
+            int i = 2;
+            for (; i < scalar_scan && clause[i]; i++)
                 if (!false_[clause[i]]) {
-                    // Swap literals
-                    clause[1] = clause[i];
-                    clause[i] = lit;
-                    int store = *watch; // Store the old watch
-                    unit = false;
-                    // Remove the watch from the list of lit
-                    *watch = db[*watch];
-                    addWatch(clause[1], store); // ToDo addWatch
-                }       // Add the watch to the list of clause[1]
+                    other = clause + i;
+                    break;
+                }
+            if (i == scalar_scan && clause[i])
+                other = scanNonFalse(false_, clause + i);
+            if (other) {
+                // Swap literals
+                clause[1] = *other;
+                *other = lit;
+                Ref store = *watch; // Store the old watch
+                unit = false;
+                // Remove the watch from the list of lit
+                *watch = link(*watch);
+                addWatch(clause[1], store); // ToDo addWatch
+            }           // Add the watch to the list of clause[1]
             if (unit) { // If the clause is indeed unit
                 clause[1] = lit;
                 // Place lit at clause[1] and update next watch
-                watch = (db + *watch);
+                watch = &link(*watch);
                 // If the other watched literal is satisfied continue
                 if (false_[-clause[0]])
                     continue;
@@ -330,6 +736,14 @@ int Solver::propagate() {
                 if (!false_[clause[0]]) {
                     // A unit clause is found, and the reason is set
                     assign(clause, forced_); // ToDo assign
+                } else if (options.chrono) {
+                    // Propagate lit again if it stays assigned (its watches
+                    // after this one weren't visited)
+                    processed--;
+                    if (chronological(clause) == UNSAT)
+                        return UNSAT;
+                    forced_ = (decisions == 0);
+                    break;
                 } else {
                     // Found a root level conflict -> UNSAT
                     if (forced_)
@@ -345,63 +759,466 @@ int Solver::propagate() {
             }
         } // end of while (*watch != END)
     }
+    // The clauses are at their fixpoint: propagate the XORs and the counts
+    if ((gauss && xor_processed < assigned) ||
+        (cards && card_processed < assigned)) {
+        int* clause = propagateXors(forced_);
+        if (!clause)
+            clause = propagateCardinalities(forced_);
+        if (clause) { // A constraint is falsified: handled as above
+            if (forced_)
+                return UNSAT;
+            int* lemma = analyze(clause);
+            if (!lemma[1])
+                forced_ = 1;
+            assign(lemma, forced_);
+        }
+        goto clauses;
+    }
     // Assign the conflict clause as a unit
     if (forced_)
         forced = processed; // Set forced if applicable
     return SAT;             // Finally, no conflict was found
 }
 
+// -----------------------------------------------------------------------------
+// Propagates the literals of the stack on the XORs
+template <class H, class R, class D, class M, class P>
+int* BasicSolver<H, R, D, M, P>::propagateXors(int forced_) {
+    if (!gauss)
+        return nullptr;
+    while (xor_processed < assigned) {
+        int lit = *(xor_processed++);
+        explanations.clear();
+        gauss->propagate(std::abs(lit), false_, explanations);
+        // An explanation is learned as a lemma and becomes the reason of its
+        // first literal; an earlier one may have assigned that literal
+        for (std::size_t i = 0; i < explanations.size();) {
+            int* in = &explanations[i];
+            int size = 0;
+            while (in[size])
+                size++;
+            i += size + 1;
+            if (false_[-in[0]]) // Already true
+                continue;
+            int* clause = addClause(in, size, 0);
+            if (false_[clause[0]]) // All literals false: a conflict
+                return clause;
+            assign(clause, forced_);
+        }
+    }
+    return nullptr;
+}
+
+// -----------------------------------------------------------------------------
+// Propagates the XORs of gauss from now on
+template <class H, class R, class D, class M, class P>
+int BasicSolver<H, R, D, M, P>::attach(std::unique_ptr<Gauss> xors) {
+    if (xors->inconsistent())
+        inconsistent = true;
+    if (inconsistent)
+        return UNSAT;
+    gauss = std::move(xors);
+    options.chrono = 0; // Their propagation relies on the order of the stack
+    xor_processed = false_stack; // The top-level literals come first
+    explanations.clear();
+    gauss->units(explanations);
+    for (int literal : explanations) {
+        if (false_[-literal]) // Already true (the XORs of a snapshot)
+            continue;
+        buffer[0] = literal;
+        if (addInput(buffer, 1) == UNSAT)
+            return UNSAT;
+    }
+    return SAT;
+}
+
+// -----------------------------------------------------------------------------
+// Counts the literals of the stack on the at-most-k constraints
+template <class H, class R, class D, class M, class P>
+int* BasicSolver<H, R, D, M, P>::propagateCardinalities(int forced_) {
+    if (!cards)
+        return nullptr;
+    while (card_processed < assigned) {
+        int lit = -*(card_processed++); // The literal that became true
+        implications.clear();
+        if (cards->propagate(lit, false_, implications)) {
+            explanations = cards->getConflict();
+            return addClause(explanations.data(), (int)explanations.size(),
+                             0);
+        }
+        // Assign the implied literals false; the reason (negative) refers
+        // to the snapshot of the true literals
+        for (std::size_t i = 0; i < implications.size(); i += 2) {
+            int literal = implications[i];
+            if (false_[literal])
+                continue; // Implied by another constraint already
+            false_[literal] = forced_ ? IMPLIED : 1;
+            *(assigned++) = literal;
+            reason[std::abs(literal)] = -(implications[i + 1] + 1);
+            model[std::abs(literal)] = (literal < 0);
+        }
+    }
+    return nullptr;
+}
+
+// -----------------------------------------------------------------------------
+// Uncounts the literals removed from the stack
+template <class H, class R, class D, class M, class P>
+void BasicSolver<H, R, D, M, P>::uncount() {
+    if (cards)
+        while (card_processed > assigned)
+            cards->undo(-*(--card_processed));
+}
+
+// -----------------------------------------------------------------------------
+// Propagates the at-most-k constraints from now on
+template <class H, class R, class D, class M, class P>
+void BasicSolver<H, R, D, M, P>::attach(
+    std::unique_ptr<Cardinality> constraints) {
+    cards = std::move(constraints);
+    options.chrono = 0; // Their counts rely on the order of the stack
+    card_processed = false_stack; // The top-level literals come first
+}
+
+// -----------------------------------------------------------------------------
+// Returns the reason of var, turning a snapshot into a clause first
+template <class H, class R, class D, class M, class P>
+Ref BasicSolver<H, R, D, M, P>::explain(int var) {
+    if (reason[var] < 0) {
+        // The true literal of var, then the negated true literals
+        explanations.assign(1, false_[var] ? -var : var);
+        for (const int* p = cards->reason(-reason[var] - 1); *p; p++)
+            explanations.push_back(-*p);
+        int* clause = addClause(explanations.data(),
+                                (int)explanations.size(), 0);
+        reason[var] = 1 + (Ref)(clause - db);
+    }
+    return reason[var];
+}
+
+// -----------------------------------------------------------------------------
+// Collects the core of the falsified assumption: walking down the stack from
+// its negation through the reasons, the decisions reached are assumptions
+// (decided first). The top-level literals (IMPLIED) follow from the formula
+// alone: they are never MARKed, so the walk stops at forced and their flags
+// stay as they are
+template <class H, class R, class D, class M, class P>
+void BasicSolver<H, R, D, M, P>::failed(int assumption) {
+    core.assign(1, assumption);
+    if (false_[assumption] == IMPLIED)
+        return; // Falsified by the formula alone
+    false_[assumption] = MARK;
+    for (int* p = assigned - 1; p >= forced; p--) {
+        if (false_[*p] != MARK)
+            continue;
+        false_[*p] = 1;
+        int var = std::abs(*p);
+        if (reason[var]) {
+            Ref explanation = explain(var); // May move the arena
+            for (int* clause = db + explanation; *clause; clause++)
+                if (false_[*clause] != IMPLIED)
+                    false_[*clause] = MARK;
+        } else {
+            core.push_back(-*p);
+        }
+    }
+}
+
 // -----------------------------------------------------------------------------
 // determines satisfiability
-int Solver::solve() {
-    // Initialize the solver
-    int decision = head;
+template <class H, class R, class D, class M, class P>
+int BasicSolver<H, R, D, M, P>::solve(int budget) {
+    core.clear();
+    if (inconsistent)
+        return UNSAT;
+    // Undo the decisions (and assumptions) of a previous call
+    if (searching())
+        restart();
     res = 0;
+    return search(budget);
+}
+
+// -----------------------------------------------------------------------------
+// Goes on with the search where the previous step stopped
+template <class H, class R, class D, class M, class P>
+int BasicSolver<H, R, D, M, P>::step(int budget) {
+    core.clear();
+    if (inconsistent)
+        return UNSAT;
+    return search(budget);
+}
+
+// -----------------------------------------------------------------------------
+// The search of solve() from the current stack
+template <class H, class R, class D, class M, class P>
+int BasicSolver<H, R, D, M, P>::search(int budget) {
+    // Initialize the solver
+    int decision = H::first(*this);
+    int limit = budget < 0 ? -1 : nConflicts + budget;
     // Main solve loop
     for (;;) {
-        // Store nLemmas to see whether propagate adds lemmas
-        int old_nLemmas = nLemmas;
+        // Store nConflicts to see whether propagate analyzed a conflict
+        int old_nConflicts = nConflicts;
         // Propagation returns UNSAT for a root level conflict
-        if (propagate() == UNSAT) // may generate a lemma through analyze()...
+        if (propagate() == UNSAT) { // may generate a lemma through analyze()
+            inconsistent = true;
+            proof.conclude();
             return UNSAT;
+        }
         // If the last decision caused a conflict
-        if (nLemmas > old_nLemmas) {
-            // Reset the decision heuristic to head
-            decision = head;
-            // If fast average is substantially larger than slow average
-            if (restarting()) {
-                printf("c restarting after %i conflicts (%i %i) %i\n", res,
-                       fast, slow, nLemmas > maxLemmas);
-                // Restart and update the averages
+        if (nConflicts > old_nConflicts) {
+            // Reset the decision heuristic to its first variable
+            decision = H::first(*this);
+            // Ask the restart policy
+            if (R::restarting(*this)) {
+                target_size = 0; // Target phases are per restart
+                if (trace)
+                    trace->record(Trace::restart, fast, slow, nConflicts);
+                if (options.verbose)
+                    printf("c restarting after %i conflicts (%i %i) %i %s\n",
+                           res, fast, slow, nLemmas > maxLemmas,
+                           stable ? "stable" : "focused");
+                // Restart (the policy has updated its state)
                 res = 0;
-                fast = (slow / 100) * 125;
                 restart(); // ToDo restart
                 // Reduce the DB when it contains too many lemmas
                 // Remove "less useful" lemmas from DB
-                if (nLemmas > maxLemmas)
-                    reduceDB(6); // ToDo reduceDB
+                if (nLemmas > maxLemmas) {
+                    reduceDB();
+                    // A blocking clause may be falsified at the top level
+                    if (inconsistent)
+                        return UNSAT;
+                }
+                // Reset the saved phases now and then
+                if (options.rephase && nConflicts >= rephase_next)
+                    rephase();
             }
+            // Give up when the conflict budget is exhausted
+            if (limit >= 0 && nConflicts >= limit)
+                return UNKNOWN;
+            // Now and then, offer to checkpoint (which may restart)
+            if (nConflicts % 256 == 0 && checkpoint && !checkpoint())
+                return UNKNOWN;
         }
-        // As long as the temporary decision is assigned
-        while (false_[decision] || false_[-decision]) {
-            // Replace it with the next variable in the decision list
-            decision = prev[decision];
+        // Assumptions are decided first, in the given order
+        int literal = 0;
+        for (int assumption : assumptions)
+            if (false_[assumption]) { // A falsified assumption: UNSAT
+                failed(assumption);   // under the assumptions only
+                return UNSAT;
+            } else if (!false_[-assumption]) {
+                literal = assumption;
+                break;
+            }
+        if (!literal) {
+            // If every variable is assigned, then a solution is found
+            if (H::decide(*this, decision) == 0)
+                return SAT;
+            // Otherwise, assign the decision variable based on the model
+            // or, when targeting, on the longest conflict-free stack
+            bool targeting =
+                options.target > 1 || (options.target == 1 && stable);
+            int phase = targeting ? target[decision] : model[decision];
+            literal = phase ? decision : -decision;
         }
-        // If the end of the list is reached, then a solution is found
-        if (decision == 0)
-            return SAT;
-        // Otherwise, assign the decision variable based on the model
-        decision = model[decision] ? decision : -decision;
         // Assign the decision literal to true (change to IMPLIED-1?)
-        false_[-decision] = 1;
+        false_[-literal] = 1;
+        model[std::abs(literal)] = (literal > 0); // Assumptions may flip it
         // And push it on the assigned stack
-        *(assigned++) = -decision;
+        *(assigned++) = -literal;
         // Decisions have no reason clauses
-        decision = std::abs(decision);
-        reason[decision] = 0;
+        reason[std::abs(literal)] = 0;
+        if (options.chrono)
+            level[std::abs(literal)] = ++decisions;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Adds the blocking clause *in of size size, falsified by the assignment
+template <class H, class R, class D, class M, class P>
+int BasicSolver<H, R, D, M, P>::block(int* in, int size) {
+    // MARK the literals, leaving out those false at the top level
+    int kept = 0;
+    for (int i = 0; i < size; i++)
+        if (false_[in[i]] == 1) {
+            false_[in[i]] = MARK;
+            in[kept++] = in[i];
+        }
+    if (!kept) {
+        inconsistent = true;
+        return UNSAT;
+    }
+    // Walk down the stack: the literals in the order of the stack (highest
+    // first), with the number of decisions above each one; decisions[a] is
+    // the decision of the level of the literals with a decisions above
+    std::vector<int*> decisions;
+    std::vector<int> above(kept);
+    int found = 0;
+    for (int* p = assigned - 1; p >= forced; p--) {
+        if (false_[*p] == MARK) {
+            false_[*p] = 1;
+            above[found] = (int)decisions.size();
+            in[found++] = *p;
+        }
+        if (!reason[std::abs(*p)])
+            decisions.push_back(p);
+    }
+    // Backjump: below the level of in[1] if in[0] is alone on the highest
+    // level, otherwise below the highest level (to the top level for a
+    // unit)
+    int* bottom;
+    if (kept == 1)
+        bottom = decisions.back();
+    else if (above[1] > above[0])
+        bottom = decisions[above[1] - 1];
+    else
+        bottom = decisions[above[0]];
+    while (assigned > bottom)
+        unassign(*(--assigned));
+    processed = assigned;
+    xor_processed = std::min(xor_processed, assigned);
+    uncount();
+    if (kept == 1) { // A unit: forced at the top level
+        if (cards)
+            cards->clearReasons();
+        int* clause = addClause(in, 1, 0);
+        blocking.push_back(clause - db);
+        assign(clause, 1);
+        return SAT;
+    }
+    int* clause = addClause(in, kept, 0);
+    blocking.push_back(clause - db);
+    if (above[1] > above[0]) {
+        // in[0] is implied on the level of in[1]: propagate that level
+        // again from its decision (the propagation knows a level from the
+        // top level by its first literal)
+        assign(clause, 0);
+        processed = decisions[above[1]];
+    }
+    return SAT;
+}
+
+// -----------------------------------------------------------------------------
+// Enumerates the models, calling found with each one
+template <class H, class R, class D, class M, class P>
+int BasicSolver<H, R, D, M, P>::enumerate(
+    const std::vector<int>& shown,
+    const std::function<bool(const int* model)>& found) {
+    options.chrono = 0; // block() backjumps by the order of the stack
+    int result = solve();
+    while (result == SAT) {
+        if (!found(model))
+            return UNKNOWN;
+        // The clause false under the model on the variables shown, or
+        // under its decisions
+        int size = 0;
+        if (shown.empty()) {
+            for (int* p = forced; p < assigned; p++)
+                if (!reason[std::abs(*p)])
+                    buffer[size++] = *p;
+        } else {
+            for (int var : shown)
+                buffer[size++] = model[var] ? -var : var;
+        }
+        if (block(buffer, size) == UNSAT)
+            return UNSAT;
+        res = 0;
+        result = search(-1);
+    }
+    return result;
+}
+
+// -----------------------------------------------------------------------------
+// Advances the reluctant doubling sequence, returns the next Luby number
+template <class H, class R, class D, class M, class P>
+int BasicSolver<H, R, D, M, P>::luby() {
+    if ((luby_u & -luby_u) == luby_v) {
+        luby_u++;
+        luby_v = 1;
+    } else {
+        luby_v *= 2;
+    }
+    return luby_v;
+}
+
+// -----------------------------------------------------------------------------
+// Saves the conflict-free part of the stack as target (and best) phases
+template <class H, class R, class D, class M, class P>
+void BasicSolver<H, R, D, M, P>::savePhases() {
+    // Drop the literals of the conflict level including its decision
+    int* top = assigned;
+    while (top > forced && reason[std::abs(*(top - 1))])
+        top--;
+    if (top > forced)
+        top--;
+    int size = (int)(top - false_stack);
+    if (size <= target_size)
+        return;
+    // A literal on the stack is false: its variable is true if it's negative
+    target_size = size;
+    for (int* p = false_stack; p < top; p++)
+        target[std::abs(*p)] = (*p < 0);
+    if (size <= best_size)
+        return;
+    best_size = size;
+    for (int* p = false_stack; p < top; p++)
+        best[std::abs(*p)] = (*p < 0);
+}
+
+// -----------------------------------------------------------------------------
+// Resets the saved phases following the rephasing schedule: original (all
+// false), inverted (all true), best, walker (falls back to best) and random,
+// each followed by best
+template <class H, class R, class D, class M, class P>
+void BasicSolver<H, R, D, M, P>::rephase() {
+    const char schedule[] = "OBIBWBRB";
+    char kind = schedule[rephased++ % 8];
+    // The walker writes its phases into target; assigned variables keep theirs
+    if (kind == 'W' && !(walker && walker(target)))
+        kind = 'B';
+    if (trace)
+        trace->record(Trace::rephase, kind);
+    for (int i = 1; i <= nVars; i++) {
+        if (false_[i] || false_[-i]) {
+            target[i] = model[i];
+            continue;
+        }
+        switch (kind) {
+        case 'O':
+            model[i] = 0;
+            break;
+        case 'I':
+            model[i] = 1;
+            break;
+        case 'B':
+            model[i] = best[i];
+            break;
+        case 'W':
+            model[i] = target[i];
+            break;
+        case 'R': // xorshift64
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            model[i] = (int)(seed >> 32) & 1;
+            break;
+        }
+        target[i] = model[i];
     }
+    target_size = 0;
+    if (kind == 'B')
+        best_size = 0;
+    // Rephase intervals grow arithmetically
+    rephase_next = nConflicts + 1000 * (rephased + 1);
 }
 
 // -----------------------------------------------------------------------------
-//
-bool Solver::restarting() { return fast > (slow / 100) * 125; }
+// The combinations of policies the driver can select
+template class microsat::BasicSolver<>;
+template class microsat::BasicSolver<Vmtf, OptionRestarts, SatisfiedReduction,
+                                     NoMinimize>;
+template class microsat::BasicSolver<Vmtf, OptionRestarts, SatisfiedReduction,
+                                     RecursiveMinimize, DratProof>;
+template class microsat::BasicSolver<Vmtf, OptionRestarts, SatisfiedReduction,
+                                     NoMinimize, DratProof>;
@@ -7,25 +7,62 @@
 #ifndef MICROSAT_SOLVER_HPP
 #define MICROSAT_SOLVER_HPP
 
+#include "cardinality.hpp"
+#include "gauss.hpp"
 #include "memory.hpp"
+#include "options.hpp"
+#include "policies.hpp"
+#include "trace.hpp"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace microsat {
 
+class Formula;
+class Snapshot;
+
 // -----------------------------------------------------------------------------
-enum { END = -9, UNSAT = 0, SAT = 1, MARK = 2, IMPLIED = 6 };
+// References to the clauses are offsets into the arena. They are 32-bit
+// unless the build defines MICROSAT_WIDE (cmake -DMICROSAT_WIDE=ON, make
+// WIDE=1): then they are 64-bit and the arena holds more than 2^31 ints.
+#ifdef MICROSAT_WIDE
+using Ref = std::int64_t;
+#else
+using Ref = int;
+#endif
 // -----------------------------------------------------------------------------
-class Solver {
+// The CDCL solver; its strategies are compile-time policies (policies.hpp)
+template <class Heuristic = Vmtf, class Restart = OptionRestarts,
+          class Reduction = SatisfiedReduction,
+          class Minimize = RecursiveMinimize, class Proof = NoProof>
+class BasicSolver {
     friend class driver;
+    friend class Batch;
+    friend class Bench;
+    friend Heuristic;
+    friend Restart;
+    friend Reduction;
+    friend Minimize;
+    friend Proof;
 
   private:
-    const static int mem_max = 1u << 30u; // the initial maximum memory
-    // 2147483647 INT32_MAX
-    // 1073741824 1u << 30u
-    // 1u << 30u;
+    // Ints of a reference (1, or 2 with wide references)
+    const static int ref_size = sizeof(Ref) / sizeof(int);
+    // The maximum memory (reserved, not committed): 2^30 ints, 2^33 with
+    // wide references
+    const static std::size_t mem_max =
+        ref_size == 1 ? std::size_t(1) << 30 : std::size_t(1) << 33;
     const static int ave_max = 1u << 24u; // the initial average
-    const int nVars;                      // The number of variables
-    const int nClauses;                   // The number of clauses
+    // Index in a clause from which propagate() scans for a replacement
+    // watch vectorized (simd.hpp): the literals before are scanned one at a
+    // time. The vector loads may read past the end of the clause, which is
+    // still in the arena.
+    const static int scalar_scan = 10;
+    int nVars;                            // The number of variables
+    int nClauses;                         // The number of clauses
     int nLemmas = 0;      // The number of learned (redundant) clauses
     int nConflicts = 0;   // Under of conflicts which is used to updates scores
     int maxLemmas = 2000; // Initial maximum number of learnt clauses
@@ -33,22 +70,41 @@ class Solver {
     int fast = ave_max; // Initialize the fast moving averages
     int slow = ave_max; // Initialize the slow moving averages
     // -------------------------------------------------------------------------
-    int mem_fixed = 0; // ?
+    Options options;
+    bool stable = false;    // Stable mode (rare restarts) or focused mode
+    int luby_u = 1;         // Knuth's reluctant doubling: the Luby sequence
+    int luby_v = 1;         // is generated as the pairs (u, v)
+    double interval = 100;  // Conflicts between geometric restarts
+    int mode_length = 1000; // Conflicts of the current mode (switching)
+    int mode_switch = 1000; // Conflicts at which the mode switches next
+    // -------------------------------------------------------------------------
+    int target_size = 0;    // Length of the stack saved in target
+    int best_size = 0;      // Length of the stack saved in best
+    int rephased = 0;       // Number of rephases so far
+    int rephase_next = 0;   // Conflicts at which the next rephase happens
+    std::uint64_t seed = 1; // State of the random phase generator
+    // -------------------------------------------------------------------------
+    Ref mem_vars = 0;  // End of the per-variable arrays (the clauses follow)
+    Ref mem_fixed = 0; // End of the input clauses (the lemmas follow)
     // -------------------------------------------------------------------------
     Memory<int> mem; // initial database
     std::vector<int, Allocator<int>> v_model{Allocator<int>{mem}};
     std::vector<int, Allocator<int>> v_prev{Allocator<int>{mem}};
     std::vector<int, Allocator<int>> v_next{Allocator<int>{mem}};
     std::vector<int, Allocator<int>> v_buffer{Allocator<int>{mem}};
-    std::vector<int, Allocator<int>> v_reason{Allocator<int>{mem}};
     std::vector<int, Allocator<int>> v_false_stack{Allocator<int>{mem}};
+    std::vector<int, Allocator<int>> v_target{Allocator<int>{mem}};
+    std::vector<int, Allocator<int>> v_best{Allocator<int>{mem}};
     int* db = nullptr;          // First pointer
     int* model = nullptr;       // Full assignment of the vars; initially false
     int* next = nullptr;        // Next variable in the heuristic order
     int* prev = nullptr;        // Previous variable in the heuristic order
     int* buffer = nullptr;      // A buffer to store a temporary clause
-    int* reason = nullptr;      // Array of clauses
+    Ref* reason = nullptr;      // Array of clauses
     int* false_stack = nullptr; // Stack of falsified literals; never changes
+    int* target = nullptr;      // Phases of the longest conflict-free stack
+                                // since the last restart
+    int* best = nullptr;        // Phases of the longest one since rephasing
     // -------------------------------------------------------------------------
     int* forced = nullptr;    // Points inside *falseStack at first decision
                               // (unforced literal)
@@ -58,44 +114,233 @@ class Solver {
                               // literal
     // -------------------------------------------------------------------------
     int* false_ = nullptr; // Labels for variables, non-zero means false
-    int* first = nullptr;  // Offset of the first watched clause
+    int* level = nullptr;  // Decision levels of the variables and the
+    int decisions = 0;     // current one (chronological backtracking only)
+    std::vector<int> lemma_levels; // The levels of a lemma (for its LBD)
+    Ref* first = nullptr;  // Offset of the first watched clause
     int head = 0;          // the head of the double-linked list
     int res = 0;           // restart counter ??
     // -------------------------------------------------------------------------
+    bool inconsistent = false;    // A top-level conflict has been found
+    std::vector<int> assumptions; // Decided first by the next solve()
+    std::vector<int> core;        // The assumptions of the last UNSAT
+    // -------------------------------------------------------------------------
+    std::unique_ptr<Gauss> gauss;  // The XORs of the formula, if any
+    int* xor_processed = nullptr;  // Points inside *falseStack at the first
+                                   // literal not propagated on the XORs
+    std::vector<int> explanations; // Clauses explaining XOR propagations
+    std::unique_ptr<Cardinality> cards; // The at-most-k constraints, if any
+    int* card_processed = nullptr;      // Points inside *falseStack at the
+                                        // first literal not counted
+    std::vector<int> implications;      // Literals implied by the counts
+    std::vector<Ref> blocking; // Blocking clauses among the lemmas; the
+                               // next reduceDB() makes them input clauses
+    // -------------------------------------------------------------------------
+    Proof proof; // Traces the lemmas
+    // -------------------------------------------------------------------------
 
   public:
+    // Provides the phases for rephasing (walker phases), writing phases[v]
+    // for every variable v; returns false if it has none
+    std::function<bool(int* phases)> walker;
+    // Called by solve() every 256 conflicts to checkpoint the search when
+    // due (with dump()); solve() gives up (UNKNOWN) when it returns false
+    std::function<bool()> checkpoint;
+    // Called with every lemma learned (its literals and size), for instance
+    // to share the short ones with other solvers
+    std::function<void(const int* lemma, int size)> learned;
+    // Records the events of the search when set (trace.hpp)
+    std::unique_ptr<Trace> trace;
+
     // The code assumes that there is at least one variable
-    explicit Solver(int vars = 1, int clauses = 0);
+    explicit BasicSolver(int vars = 1, int clauses = 0, Options options = {});
+    // Reinitializes the solver for a new formula reusing the same arena
+    void reset(int vars, int clauses);
+    // Writes the arena and the state of the search to the snapshot path,
+    // with formula to check the models against; restarts first
+    void dump(const std::string& path, const Formula& formula);
+    // Reinitializes the solver with the arena and the search of snapshot,
+    // the arena mapped rather than read; the caller attaches the XORs and
+    // constraints again
+    void load(const Snapshot& snapshot);
     // Adds a clause stored in *in of size size
     int* addClause(int* in, int size, int irr);
+    // Adds an input clause at the top level (backtracking if needed);
+    // returns UNSAT if the formula became unsatisfiable
+    int addInput(int* in, int size);
+    // Propagates the top-level units; returns UNSAT on a conflict
+    int simplify();
+    // Sets the assumptions (literals) for the next call of solve()
+    void assume(const int* in, int size);
+    // The assumptions that the last UNSAT of solve() or step() follows
+    // from (an unsatisfiable core of them; empty: the formula alone is
+    // unsatisfiable)
+    [[nodiscard]] const std::vector<int>& getCore() const { return core; }
     // Adds a watch pointer to a clause containing lit
-    void addWatch(int literal, int mem);
+    void addWatch(int literal, Ref watch);
+    // The watch of the clause at head on its (k+1)-th literal: the offset
+    // of its link with 32-bit references; with wide references, where the
+    // links take two ints each, head times 2 plus k
+    static Ref watchOf(Ref head, int k) {
+        return ref_size == 1 ? head + k : 2 * head + k;
+    }
+    // The link of watch to the next watch of its list
+    Ref& link(Ref watch) {
+        if (ref_size == 1)
+            return *reinterpret_cast<Ref*>(db + watch);
+        return *reinterpret_cast<Ref*>(db + (watch >> 1) + (watch & 1) * 2);
+    }
+    // The literals of the clause of watch
+    int* literals(Ref watch) {
+        if (ref_size > 1)
+            return db + (watch >> 1) + 2 * ref_size;
+        int* clause = db + watch + 1; // it might be the first or second
+        // Set the pointer to the first literal in the clause
+        // if this is the second watch literal, then forward the pointer...
+        if (clause[-2] == 0) // all clauses ends with a 0... even there is
+            clause++;        // a zero before the first clause....
+        return clause;
+    }
+    // Whether watch is on an input clause
+    bool input(Ref watch) {
+        return (ref_size == 1 ? watch : watch >> 1) < mem_fixed;
+    }
+    // Rounds offset up to the alignment of a reference
+    static Ref align(Ref offset) { return (offset + ref_size - 1) & -ref_size; }
+    // Carves size references out of the arena
+    Ref* allocateRefs(std::size_t size) {
+        if (ref_size > 1)
+            mem.resize(align(mem_used()));
+        return reinterpret_cast<Ref*>(mem.allocate(size * ref_size));
+    }
     // Perform a restart (i.e., unassign all variables)
     void restart();
     // Unassign the literal
     void unassign(int literal);
     // assign the literal
     void assign(const int* reason, int forced);
-    // Move the variable to the front of the decision list
-    void bump(int literal);
+    // Bumps the variable of literal (Heuristic policy)
+    void bump(int literal) { Heuristic::bump(*this, literal); }
     // Check if literal is implied by MARK literals
     int implied(int literal);
     // Compute a resolvent from falsified clause
     int* analyze(int* clause);
+    // Chronological backtracking (Nadel & Ryvchin, SAT 2018), when
+    // options.chrono is set: the literals are assigned at the highest level
+    // of their reasons, which may be below the current one (out of order on
+    // the stack).
+    // Unassigns the literals above level target, keeping the lower ones
+    // assigned out of order above them (to be propagated again)
+    void backtrack(int target);
+    // Learns the first-UIP lemma of the falsified clause at the current
+    // level, conflict_level (the stack is not changed)
+    int* analyzeChrono(int* clause, int conflict_level);
+    // Handles a conflict on the falsified clause: backtracks to its level,
+    // learns the lemma and asserts it, backtracking only one level if the
+    // backjump would be longer than options.chrono levels. Returns UNSAT
+    // for a conflict at the top level.
+    int chronological(int* clause);
     // Performs unit propagation
     int propagate();
-    // determines satisfiability
-    int solve();
-    // Removes "less useful" lemmas from DB
-    // Reduce the DB when it contains too many lemmas
-    void reduceDB(int k);
-    // Restarting Rule (Glucose scheme using exponential moving averages
-    bool restarting();
+    // Propagates the literals of the stack on the XORs; returns the
+    // falsified explanation on a conflict, otherwise nullptr
+    int* propagateXors(int forced);
+    // Propagates the XORs of gauss from now on; returns UNSAT if they are
+    // inconsistent
+    int attach(std::unique_ptr<Gauss> xors);
+    // Counts the literals of the stack on the at-most-k constraints;
+    // returns the falsified explanation on a conflict, otherwise nullptr
+    int* propagateCardinalities(int forced);
+    // Uncounts the literals removed from the stack
+    void uncount();
+    // Propagates the at-most-k constraints from now on
+    void attach(std::unique_ptr<Cardinality> constraints);
+    // Returns the reason of var, turning a snapshot into a clause first
+    Ref explain(int var);
+    // Collects in core the falsified assumption and the assumptions on the
+    // stack that its negation was implied by
+    void failed(int assumption);
+    // determines satisfiability under the assumptions; returns UNKNOWN
+    // when budget conflicts (negative: no limit) did not suffice
+    int solve(int budget = -1);
+    // Resumable solving, to interleave many solvers on one thread: goes on
+    // with the search where the previous step (or solve()) stopped until
+    // budget more conflicts (at least one; negative: no limit), instead of
+    // starting over like solve(). Returns SAT or UNSAT once decided,
+    // otherwise UNKNOWN with the search intact for the next step. Between
+    // the steps, the clauses and assumptions stay as they are: addInput()
+    // and solve() start over.
+    int step(int budget);
+    // The search of solve() from the current stack (the restart count
+    // res as it is)
+    int search(int budget);
+    // Adds the clause *in of size size, falsified by the current (full)
+    // assignment, as a blocking clause and backjumps only as far as needed
+    // for it: to the second highest level of its literals, asserting the
+    // only literal of the highest level, otherwise below the highest level.
+    // Returns UNSAT if the clause is falsified at the top level.
+    int block(int* in, int size);
+    // Enumerates the models, calling found with each one (model[v]: the
+    // value of v) until it returns false. Each model is blocked on the
+    // variables shown (on its decisions if none is shown, which blocks the
+    // complete model). Returns UNSAT once every model has been found,
+    // UNKNOWN if found stopped the enumeration.
+    int enumerate(const std::vector<int>& shown,
+                  const std::function<bool(const int* model)>& found);
+    // Removes "less useful" lemmas from DB (those the Reduction policy
+    // doesn't keep)
+    void reduceDB();
+    // Advances the reluctant doubling sequence, returns the next Luby number
+    int luby();
+    // Saves the conflict-free part of the stack as target (and best) phases
+    void savePhases();
+    // Resets the saved phases following the rephasing schedule
+    void rephase();
 
     int* getModel() { return model; }
     int getVars() { return nVars; }
-    int mem_used() { return mem.mem_used(); }
+    // Whether decisions of a previous solve() are still on the stack
+    bool searching() {
+        return assigned > forced && !reason[std::abs(*forced)];
+    }
+    Ref mem_used() { return (Ref)mem.mem_used(); }
+    // The arena by category, in ints
+    struct Usage {
+        std::size_t variables = 0; // The per-variable arrays
+        std::size_t input = 0;     // The input clauses (with their 0)
+        std::size_t lemmas = 0;    // The lemmas (with their 0)
+        std::size_t watches = 0;   // The heads of the watch lists and the
+                                   // links in the clauses
+        std::size_t waste = 0;     // Alignment padding and memory freed
+                                   // (which the arena doesn't reuse)
+        std::size_t garbage = 0;   // Above the used part, left behind by
+                                   // the reductions (the pages stay
+                                   // committed until clauses reuse them)
+        std::size_t high = 0;      // The high-water mark
+    };
+    // Accounts the arena, walking the clauses
+    Usage usage();
 };
+// -----------------------------------------------------------------------------
+// Today's solver, used unless the command line asks for something else
+using Solver = BasicSolver<>;
+// Without lemma minimization
+using PlainSolver = BasicSolver<Vmtf, OptionRestarts, SatisfiedReduction,
+                                NoMinimize>;
+// With a DRAT proof of unsatisfiability
+using ProofSolver = BasicSolver<Vmtf, OptionRestarts, SatisfiedReduction,
+                                RecursiveMinimize, DratProof>;
+using PlainProofSolver = BasicSolver<Vmtf, OptionRestarts, SatisfiedReduction,
+                                     NoMinimize, DratProof>;
+// The member functions are defined (and these combinations instantiated)
+// in solver.cpp
+extern template class BasicSolver<>;
+extern template class BasicSolver<Vmtf, OptionRestarts, SatisfiedReduction,
+                                  NoMinimize>;
+extern template class BasicSolver<Vmtf, OptionRestarts, SatisfiedReduction,
+                                  RecursiveMinimize, DratProof>;
+extern template class BasicSolver<Vmtf, OptionRestarts, SatisfiedReduction,
+                                  NoMinimize, DratProof>;
 
 } // namespace microsat
 
@@ -0,0 +1,282 @@
+//  ----------------------------------------------------------------------------
+//  Implementation file for the Symmetry class.                     symmetry.cpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#include "symmetry.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+
+using namespace microsat;
+
+namespace {
+
+// -----------------------------------------------------------------------------
+// The vertex of a literal: 2(v-1) for v and 2(v-1)+1 for -v
+int vertex(int literal) {
+    return 2 * (std::abs(literal) - 1) + (literal < 0);
+}
+
+// -----------------------------------------------------------------------------
+// The literal of a vertex below 2 * nVars
+int literal(int vertex) {
+    return (vertex & 1) ? -(vertex / 2 + 1) : vertex / 2 + 1;
+}
+
+// -----------------------------------------------------------------------------
+// Number of colors of a partition
+int count(const std::vector<int>& colors) {
+    std::vector<int> sorted(colors);
+    std::sort(sorted.begin(), sorted.end());
+    return (int)(std::unique(sorted.begin(), sorted.end()) - sorted.begin());
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// Builds the colored graph and searches the generators
+Symmetry::Symmetry(const Formula& formula, double seconds)
+    : nVars(formula.getVars()) {
+    deadline = std::chrono::steady_clock::now() +
+               std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                   std::chrono::duration<double>(seconds));
+    const int literals = 2 * nVars;
+    nVertices = literals + formula.getClauses();
+    if (nVertices + 2 * (int)formula.getLiterals().size() > size_max ||
+        !formula.getCardinalities().empty()) {
+        timeout = true; // Too large (or not only clauses) to search at all
+        return;
+    }
+    // The edges: literal to negation, clause to its literals
+    std::vector<std::pair<int, int>> edges;
+    std::vector<int> clause;
+    for (int v = 0; v < literals; v += 2)
+        edges.emplace_back(v, v + 1);
+    for (int literal : formula.getLiterals()) {
+        if (literal) {
+            clause.push_back(literal);
+            continue;
+        }
+        int c = literals + (int)clauses.size();
+        for (int lit : clause)
+            edges.emplace_back(c, vertex(lit));
+        std::sort(clause.begin(), clause.end());
+        clauses.push_back(clause);
+        clause.clear();
+    }
+    std::sort(clauses.begin(), clauses.end());
+    adjacency_start.assign(nVertices + 1, 0);
+    for (auto& [a, b] : edges) {
+        adjacency_start[a + 1]++;
+        adjacency_start[b + 1]++;
+    }
+    for (int v = 0; v < nVertices; v++)
+        adjacency_start[v + 1] += adjacency_start[v];
+    adjacency.resize(2 * edges.size());
+    std::vector<int> fill(adjacency_start.begin(), adjacency_start.end() - 1);
+    for (auto& [a, b] : edges) {
+        adjacency[fill[a]++] = b;
+        adjacency[fill[b]++] = a;
+    }
+    orbit.resize(nVertices);
+    std::iota(orbit.begin(), orbit.end(), 0);
+    // The first path: split the first non-singleton cell until discrete
+    std::vector<int> colors(nVertices, 0), choices;
+    std::fill(colors.begin() + literals, colors.end(), 1);
+    refine(colors);
+    left.push_back(colors);
+    while (count(left.back()) < nVertices && !expired()) {
+        const std::vector<int>& partition = left.back();
+        std::vector<int> size(nVertices, 0);
+        for (int color : partition)
+            size[color]++;
+        int target = 0;
+        while (size[target] < 2)
+            target++;
+        int v = 0;
+        while (partition[v] != target)
+            v++;
+        targets.push_back(target);
+        choices.push_back(v);
+        left.push_back(individualize(partition, v));
+    }
+    if (timeout)
+        return;
+    // From the bottom up: map the choice at each level to the other
+    // vertices of its cell, one per orbit
+    for (int level = (int)targets.size() - 1; level >= 0; level--)
+        for (int w = 0; w < nVertices && !expired(); w++) {
+            if (left[level][w] != targets[level] ||
+                find(w) == find(choices[level]))
+                continue;
+            std::vector<int> right = individualize(left[level], w);
+            if (compatible(right, left[level + 1]))
+                match(right, level + 1);
+        }
+}
+
+// -----------------------------------------------------------------------------
+// Refines colors to the coarsest equitable partition
+int Symmetry::refine(std::vector<int>& colors) const {
+    int colors_old = count(colors);
+    std::vector<std::vector<int>> signature(nVertices);
+    std::vector<int> order(nVertices);
+    for (;;) {
+        // A vertex is known by its color and the colors of its neighbors
+        for (int v = 0; v < nVertices; v++) {
+            std::vector<int>& s = signature[v];
+            s.assign(1, colors[v]);
+            for (int i = adjacency_start[v]; i < adjacency_start[v + 1]; i++)
+                s.push_back(colors[adjacency[i]]);
+            std::sort(s.begin() + 1, s.end());
+        }
+        // The new colors are the ranks of the signatures
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&signature](int a, int b) {
+            return signature[a] < signature[b];
+        });
+        int color = 0;
+        for (int i = 0; i < nVertices; i++) {
+            if (i && signature[order[i]] != signature[order[i - 1]])
+                color++;
+            colors[order[i]] = color;
+        }
+        if (color + 1 == colors_old)
+            return colors_old; // No cell was split
+        colors_old = color + 1;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Individualizes vertex v of colors and refines
+std::vector<int> Symmetry::individualize(const std::vector<int>& colors,
+                                         int v) const {
+    std::vector<int> result(colors);
+    result[v] = nVertices; // A color of its own
+    refine(result);
+    return result;
+}
+
+// -----------------------------------------------------------------------------
+// Whether two partitions have the same cell sizes
+bool Symmetry::compatible(const std::vector<int>& a,
+                          const std::vector<int>& b) {
+    std::vector<int> sizes(a.size() + 1, 0);
+    for (int color : a)
+        sizes[color]++;
+    for (int color : b)
+        if (--sizes[color] < 0)
+            return false;
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Completes the right path from colors at level to an automorphism
+bool Symmetry::match(const std::vector<int>& colors, int level) {
+    if (level == (int)targets.size())
+        return automorphism(colors);
+    for (int u = 0; u < nVertices && !expired(); u++) {
+        if (colors[u] != targets[level])
+            continue;
+        std::vector<int> right = individualize(colors, u);
+        if (compatible(right, left[level + 1]) && match(right, level + 1))
+            return true;
+    }
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+// Keeps the leaf pair if it is an automorphism of the formula
+bool Symmetry::automorphism(const std::vector<int>& right) {
+    const std::vector<int>& leaf = left.back();
+    // Both leaves are discrete: equal colors are mapped onto each other
+    std::vector<int> vertex_of(nVertices), image(nVertices);
+    for (int u = 0; u < nVertices; u++)
+        vertex_of[right[u]] = u;
+    for (int v = 0; v < nVertices; v++)
+        image[v] = vertex_of[leaf[v]];
+    std::vector<int> generator(nVars + 1, 0);
+    bool identity = true;
+    for (int v = 0; v < 2 * nVars; v += 2) {
+        if (image[v] >= 2 * nVars || image[v + 1] != (image[v] ^ 1))
+            return false;
+        generator[v / 2 + 1] = literal(image[v]);
+        identity &= (image[v] == v);
+    }
+    // The clauses must be mapped onto the clauses
+    std::vector<int> mapped;
+    for (auto& clause : clauses) {
+        mapped.clear();
+        for (int lit : clause)
+            mapped.push_back(lit > 0 ? generator[lit] : -generator[-lit]);
+        std::sort(mapped.begin(), mapped.end());
+        if (!std::binary_search(clauses.begin(), clauses.end(), mapped))
+            return false;
+    }
+    for (int v = 0; v < nVertices; v++)
+        orbit[find(v)] = find(image[v]);
+    if (!identity)
+        generators.push_back(std::move(generator));
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Finds the representative of the orbit of v
+int Symmetry::find(int v) {
+    while (orbit[v] != v)
+        v = orbit[v] = orbit[orbit[v]];
+    return v;
+}
+
+// -----------------------------------------------------------------------------
+// Whether the time limit is exceeded
+bool Symmetry::expired() {
+    if (!timeout && std::chrono::steady_clock::now() > deadline)
+        timeout = true;
+    return timeout;
+}
+
+// -----------------------------------------------------------------------------
+// Appends the symmetry-breaking clauses of every generator. With the
+// variables x1 < x2 < ... moved by the generator g, level k is
+//     (x1 = g(x1)) & ... & (x(k-1) = g(x(k-1))) -> (xk <= g(xk))
+// written as 2^(k-1) clauses, each negating every equality by one of
+// (xj | g(xj)) or (-xj | -g(xj)).
+void Symmetry::breaking(std::vector<int>& out, int levels) const {
+    std::vector<int> prefix, clause;
+    for (auto& generator : generators) {
+        prefix.clear();
+        for (int v = 1; v <= nVars && (int)prefix.size() < 2 * levels; v++) {
+            int image = generator[v];
+            if (image == v)
+                continue;
+            int k = (int)prefix.size() / 2;
+            for (int mask = 0; mask < (1 << k); mask++) {
+                clause.assign({-v, image});
+                for (int j = 0; j < k; j++) {
+                    int sign = (mask >> j) & 1 ? 1 : -1;
+                    clause.push_back(sign * prefix[2 * j]);
+                    clause.push_back(sign * prefix[2 * j + 1]);
+                }
+                std::sort(clause.begin(), clause.end());
+                clause.erase(std::unique(clause.begin(), clause.end()),
+                             clause.end());
+                bool tautology = false;
+                for (int lit : clause)
+                    tautology |=
+                        std::binary_search(clause.begin(), clause.end(), -lit);
+                if (tautology)
+                    continue;
+                out.insert(out.end(), clause.begin(), clause.end());
+                out.push_back(0);
+            }
+            if (image == -v) // v = g(v) is impossible: no further levels
+                break;
+            prefix.push_back(v);
+            prefix.push_back(image);
+        }
+    }
+}
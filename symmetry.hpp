@@ -0,0 +1,75 @@
+//  ----------------------------------------------------------------------------
+//  Header file for the Symmetry class.                             symmetry.hpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#ifndef MICROSAT_SYMMETRY_HPP
+#define MICROSAT_SYMMETRY_HPP
+
+#include "formula.hpp"
+#include <chrono>
+#include <vector>
+
+namespace microsat {
+
+// -----------------------------------------------------------------------------
+// Static symmetry breaking. The formula becomes the colored graph with a
+// vertex for every literal (color 0) and every clause (color 1), an edge
+// between the two literals of each variable and between every clause and
+// its literals. Generators of its automorphism group are searched like in
+// nauty: the first path of the search tree individualizes a vertex of the
+// first non-singleton cell and refines to an equitable partition until the
+// partition is discrete; then, from the bottom up, every other vertex of the
+// cell at each level (but one per orbit) is tried on the right, and the
+// leaves reached are kept when they map the clauses onto the clauses. Every
+// generator yields the first levels of its lex-leader constraint (in the
+// order of the variables) as clauses without auxiliary variables.
+class Symmetry {
+  private:
+    const static int size_max = 1 << 22; // Largest graph (vertices + edges)
+    int nVars;                           // The number of variables
+    int nVertices = 0;                   // Literals (2 per variable), clauses
+    std::vector<int> adjacency;          // The neighbors of all vertices
+    std::vector<int> adjacency_start;    // Of vertex v from adjacency_start[v]
+    std::vector<std::vector<int>> clauses; // The sorted clauses, sorted
+    std::vector<std::vector<int>> left;    // Partitions of the first path
+    std::vector<int> targets; // Color of the cell split at each level
+    std::vector<int> orbit;   // Union-find forest of the orbits
+    std::vector<std::vector<int>> generators; // Image of every variable
+    std::chrono::steady_clock::time_point deadline; // Time limit
+    bool timeout = false; // The search ran out of time
+
+    // Refines colors to the coarsest equitable partition (canonically
+    // numbered), returns the number of colors
+    int refine(std::vector<int>& colors) const;
+    // Individualizes vertex v of colors and refines
+    std::vector<int> individualize(const std::vector<int>& colors,
+                                   int v) const;
+    // Whether two partitions have the same cell sizes
+    static bool compatible(const std::vector<int>& a,
+                           const std::vector<int>& b);
+    // Completes the right path from colors at level to an automorphism
+    bool match(const std::vector<int>& colors, int level);
+    // Keeps the leaf pair if it is an automorphism of the formula
+    bool automorphism(const std::vector<int>& right);
+    // Finds the representative of the orbit of v
+    int find(int v);
+    // Whether the time limit is exceeded
+    bool expired();
+
+  public:
+    // Searches the generators for at most seconds
+    Symmetry(const Formula& formula, double seconds);
+
+    // Appends the symmetry-breaking clauses (0 terminated) of the first
+    // levels of the lex-leader constraint of every generator
+    void breaking(std::vector<int>& out, int levels = 3) const;
+
+    [[nodiscard]] int getGenerators() const { return (int)generators.size(); }
+    [[nodiscard]] bool timedOut() const { return timeout; }
+};
+
+} // namespace microsat
+
+#endif // MICROSAT_SYMMETRY_HPP
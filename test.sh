@@ -17,6 +17,25 @@ bash bench2.sh
 printf "\n$>bench3.sh\n\n"
 bash bench3.sh
 
+printf "\n$>paths.sh\n\n"
+bash paths.sh
+
+printf "\n$>models.sh\n\n"
+bash models.sh
+
+printf "\n$>snapshot.sh\n\n"
+bash snapshot.sh
+
+printf "\n$>maxsat.sh\n\n"
+bash maxsat.sh
+
+printf "\n$>microsat-bench --filter step\n\n"
+if ../../.././microsat-bench --reps 1 --warmup 0 --filter step >/dev/null; then
+  echo "step() Pass!"
+else
+  echo "step() Wrong!"
+fi
+
 printf '%s\n' ""
 printf '%s\n' "--------------------- Finalize tests --------------------------"
 printf '%s\n' "==============================================================="
@@ -0,0 +1,84 @@
+//  ----------------------------------------------------------------------------
+//  Implementation file for the Trace class.                           trace.cpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#include "trace.hpp"
+
+#include <cstdio>
+
+using namespace microsat;
+
+// -----------------------------------------------------------------------------
+// Allocates the ring and notes the start
+Trace::Trace(std::size_t capacity) {
+    std::size_t size = 1;
+    while (size < capacity)
+        size *= 2;
+    events.resize(size);
+    mask = size - 1;
+    start_ticks = ticks();
+    start_time = std::chrono::steady_clock::now();
+}
+
+// -----------------------------------------------------------------------------
+// Writes the events kept, oldest first, as a JSON array of trace events: the
+// conflicts and the restarts as counters (graphs of their values), the
+// others as instant events. The ticks are converted to microseconds since
+// the start at the rate measured from it to now.
+bool Trace::write(const std::string& path) const {
+    FILE* out = fopen(path.c_str(), "w");
+    if (!out)
+        return false;
+    double elapsed = std::chrono::duration<double, std::micro>(
+                         std::chrono::steady_clock::now() - start_time)
+                         .count();
+    std::uint64_t now = ticks();
+    double rate = now > start_ticks ? elapsed / double(now - start_ticks) : 0;
+    fprintf(out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+                 "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+                 "\"args\":{\"name\":\"microsat++\"}}");
+    std::uint64_t first =
+        recorded > events.size() ? recorded - events.size() : 0;
+    for (std::uint64_t i = first; i < recorded; i++) {
+        const Event& event = events[i & mask];
+        double time = double(event.ticks - start_ticks) * rate;
+        fprintf(out, ",\n{\"pid\":1,\"tid\":1,\"ts\":%.3f,", time);
+        switch (event.kind) {
+        case conflict:
+            fprintf(out,
+                    "\"name\":\"conflict\",\"ph\":\"C\",\"args\":{\"lbd\":%d,"
+                    "\"size\":%d,\"backjump\":%d}}",
+                    event.a, event.b, event.c);
+            break;
+        case restart:
+            fprintf(out,
+                    "\"name\":\"restart\",\"ph\":\"C\",\"args\":{\"fast\":%d,"
+                    "\"slow\":%d}},\n{\"pid\":1,\"tid\":1,\"ts\":%.3f,"
+                    "\"name\":\"restart\",\"ph\":\"i\",\"s\":\"t\","
+                    "\"args\":{\"conflicts\":%d}}",
+                    event.a, event.b, time, event.c);
+            break;
+        case reduce:
+            fprintf(out,
+                    "\"name\":\"reduce\",\"ph\":\"i\",\"s\":\"t\",\"args\":{"
+                    "\"before\":%d,\"after\":%d,\"limit\":%d}}",
+                    event.a, event.b, event.c);
+            break;
+        case mode:
+            fprintf(out,
+                    "\"name\":\"%s\",\"ph\":\"i\",\"s\":\"p\",\"args\":{}}",
+                    event.a ? "stable mode" : "focused mode");
+            break;
+        case rephase:
+            fprintf(out,
+                    "\"name\":\"rephase\",\"ph\":\"i\",\"s\":\"t\",\"args\":{"
+                    "\"kind\":\"%c\"}}",
+                    (char)event.a);
+            break;
+        }
+    }
+    fprintf(out, "\n]}\n");
+    return fclose(out) == 0;
+}
@@ -0,0 +1,82 @@
+//  ----------------------------------------------------------------------------
+//  Header file for the Trace class.                                   trace.hpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#ifndef MICROSAT_TRACE_HPP
+#define MICROSAT_TRACE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MICROSAT_TSC 1
+#include <x86intrin.h>
+#endif
+
+namespace microsat {
+
+// -----------------------------------------------------------------------------
+// Records the events of a search in a ring buffer, which keeps the latest
+// ones, to be written in the Chrome trace format (JSON, which Perfetto and
+// chrome://tracing open). An event is a few stores stamped with the time
+// stamp counter (the steady clock where there is none), converted to time
+// only when written; a solver without a trace only tests its pointer.
+class Trace {
+  public:
+    // The events and their values:
+    //   conflict: LBD, size of the lemma, levels of the backjump;
+    //   restart:  the fast and slow LBD averages, conflicts so far;
+    //   reduce:   lemmas before and after the reduction, the new limit;
+    //   mode:     1 stable mode, 0 focused mode (switching restarts);
+    //   rephase:  the kind of phases (see BasicSolver::rephase()).
+    enum Kind : std::uint8_t { conflict, restart, reduce, mode, rephase };
+
+  private:
+    struct Event {
+        std::uint64_t ticks;
+        int a, b, c;
+        Kind kind;
+    };
+    std::vector<Event> events; // The ring, of a power of two size
+    std::size_t mask;          // Its size minus 1
+    std::uint64_t recorded = 0; // Events so far; the next goes to recorded
+                                // & mask
+    // The start, to convert the ticks to time
+    std::uint64_t start_ticks;
+    std::chrono::steady_clock::time_point start_time;
+
+    static std::uint64_t ticks() {
+#ifdef MICROSAT_TSC
+        return __rdtsc();
+#else
+        return (std::uint64_t)std::chrono::steady_clock::now()
+            .time_since_epoch()
+            .count();
+#endif
+    }
+
+  public:
+    // Keeps the latest capacity events (rounded up to a power of two)
+    explicit Trace(std::size_t capacity);
+
+    void record(Kind kind, int a = 0, int b = 0, int c = 0) {
+        Event& event = events[recorded++ & mask];
+        event.ticks = ticks();
+        event.a = a;
+        event.b = b;
+        event.c = c;
+        event.kind = kind;
+    }
+    // Writes the events kept to path (replacing it); returns false if it
+    // can't be written
+    bool write(const std::string& path) const;
+    [[nodiscard]] std::uint64_t getRecorded() const { return recorded; }
+};
+
+} // namespace microsat
+
+#endif // MICROSAT_TRACE_HPP
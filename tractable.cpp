@@ -0,0 +1,248 @@
+//  ----------------------------------------------------------------------------
+//  Implementation file for the Tractable class.                   tractable.cpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#include "tractable.hpp"
+
+#include "options.hpp"
+#include <algorithm>
+#include <utility>
+
+using namespace microsat;
+
+// -----------------------------------------------------------------------------
+// Classifies the formula on the shape of its clauses
+Tractable::Fragment Tractable::classify() const {
+    int longest = 0, positives = 0, negatives = 0;
+    bool units = false;
+    int size = 0, positive = 0;
+    for (int literal : formula.getLiterals())
+        if (literal) {
+            size++;
+            positive += (literal > 0);
+        } else {
+            longest = std::max(longest, size);
+            positives = std::max(positives, positive);
+            negatives = std::max(negatives, size - positive);
+            units = units || size <= 1;
+            size = positive = 0;
+        }
+    if (longest <= 2)
+        return Fragment::binary;
+    if (positives <= 1)
+        return Fragment::horn;
+    if (negatives <= 1)
+        return Fragment::dual;
+    return units ? Fragment::units : Fragment::general;
+}
+
+// -----------------------------------------------------------------------------
+// Decides the formula of fragment into a scratch model, copied to model
+// only if SAT: the values of a failed attempt would overwrite those the
+// solver fixed from clauses not in the formula (symmetry breaking)
+int Tractable::solve(Fragment fragment, int* model) {
+    std::vector<int> scratch(formula.getVars() + 1, 0);
+    int result = decide(fragment, scratch.data());
+    if (result == SAT)
+        std::copy(scratch.begin() + 1, scratch.end(), model + 1);
+    return result;
+}
+
+// -----------------------------------------------------------------------------
+// Decides the formula of fragment, writing to model in any case
+int Tractable::decide(Fragment fragment, int* model) {
+    if (fragment == Fragment::binary)
+        return binary(model);
+    if (propagate() == UNSAT)
+        return UNSAT;
+    if (fragment == Fragment::horn)
+        return complete(model, 0);
+    if (fragment == Fragment::dual)
+        return complete(model, 1);
+    if (fragment == Fragment::units && complete(model, 0) == SAT)
+        return SAT;
+    return fragment == Fragment::units ? complete(model, 1) : UNKNOWN;
+}
+
+// -----------------------------------------------------------------------------
+// Decides a 2-CNF formula: it is UNSAT iff a literal and its negation are in
+// the same strongly connected component of the implication graph (a clause
+// a | b is the edges -a -> b and -b -> a, a unit a the edge -a -> a).
+// Tarjan's algorithm (without recursion) numbers the components in reverse
+// topological order; a literal is true if its component comes after the
+// component of its negation in the topological order.
+int Tractable::binary(int* model) {
+    int vars = formula.getVars(), nodes = 2 * vars + 2;
+    const std::vector<int>& literals = formula.getLiterals();
+    // The edges, by source
+    offsets.assign(nodes + 1, 0);
+    for (std::size_t i = 0, start = 0; i < literals.size(); i++) {
+        if (literals[i])
+            continue;
+        int size = (int)(i - start);
+        if (size == 0)
+            return UNSAT;
+        int a = literals[start], b = literals[i - 1];
+        offsets[index(-a) + 1]++;
+        if (size == 2)
+            offsets[index(-b) + 1]++;
+        start = i + 1;
+    }
+    for (int node = 0; node < nodes; node++)
+        offsets[node + 1] += offsets[node];
+    occurrences.resize(offsets[nodes]);
+    std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (std::size_t i = 0, start = 0; i < literals.size(); i++) {
+        if (literals[i])
+            continue;
+        int a = literals[start], b = literals[i - 1];
+        occurrences[fill[index(-a)]++] = index(b);
+        if (i - start == 2)
+            occurrences[fill[index(-b)]++] = index(a);
+        start = i + 1;
+    }
+    // Tarjan's algorithm; order[n] is 0 until node n is visited, component
+    // -1 while it is on the stack
+    std::vector<int> order(nodes, 0), low(nodes, 0), component(nodes, -1);
+    std::vector<int> stack;
+    std::vector<std::pair<int, int>> calls; // Node and its next edge
+    int visited = 0, components = 0;
+    for (int root = 2; root < nodes; root++) {
+        if (order[root])
+            continue;
+        calls.emplace_back(root, offsets[root]);
+        order[root] = low[root] = ++visited;
+        stack.push_back(root);
+        while (!calls.empty()) {
+            int node = calls.back().first;
+            int& edge = calls.back().second;
+            if (edge < offsets[node + 1]) {
+                int next = occurrences[edge++];
+                if (!order[next]) {
+                    order[next] = low[next] = ++visited;
+                    stack.push_back(next);
+                    calls.emplace_back(next, offsets[next]);
+                } else if (component[next] < 0) {
+                    low[node] = std::min(low[node], order[next]);
+                }
+                continue;
+            }
+            calls.pop_back();
+            if (low[node] == order[node]) { // The root of a component
+                int member;
+                do {
+                    member = stack.back();
+                    stack.pop_back();
+                    component[member] = components;
+                } while (member != node);
+                components++;
+            }
+            if (!calls.empty()) {
+                int parent = calls.back().first;
+                low[parent] = std::min(low[parent], low[node]);
+            }
+        }
+    }
+    for (int var = 1; var <= vars; var++) {
+        if (component[index(var)] == component[index(-var)])
+            return UNSAT;
+        model[var] = component[index(var)] < component[index(-var)];
+    }
+    return SAT;
+}
+
+// -----------------------------------------------------------------------------
+// Propagates the unit clauses: counts the literals of each clause not false,
+// and a clause not satisfied whose count drops to one implies its last
+// literal. Each clause is scanned once for it, so the time is linear.
+int Tractable::propagate() {
+    int vars = formula.getVars(), clauses = formula.getClauses();
+    const std::vector<int>& literals = formula.getLiterals();
+    // The clauses of every literal
+    offsets.assign(2 * vars + 3, 0);
+    for (int literal : literals)
+        if (literal)
+            offsets[index(literal) + 1]++;
+    for (int node = 0; node < 2 * vars + 2; node++)
+        offsets[node + 1] += offsets[node];
+    occurrences.resize(offsets[2 * vars + 2]);
+    std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+    std::vector<int> starts(clauses), count(clauses);
+    std::vector<char> satisfied(clauses, 0);
+    std::vector<int> trail; // The literals assigned true
+    values.assign(vars + 1, 0);
+    int clause = 0;
+    for (std::size_t i = 0, start = 0; i < literals.size(); i++)
+        if (literals[i]) {
+            occurrences[fill[index(literals[i])]++] = clause;
+        } else {
+            starts[clause] = (int)start;
+            count[clause] = (int)(i - start);
+            if (count[clause] == 0)
+                return UNSAT;
+            if (count[clause] == 1) { // A unit clause
+                int unit = literals[start];
+                if (value(unit) < 0)
+                    return UNSAT;
+                if (!value(unit)) {
+                    values[std::abs(unit)] = unit > 0 ? 1 : -1;
+                    trail.push_back(unit);
+                }
+            }
+            clause++;
+            start = i + 1;
+        }
+    for (std::size_t next = 0; next < trail.size(); next++) {
+        int literal = trail[next];
+        for (int o = offsets[index(literal)]; o < offsets[index(literal) + 1];
+             o++)
+            satisfied[occurrences[o]] = 1;
+        for (int o = offsets[index(-literal)];
+             o < offsets[index(-literal) + 1]; o++) {
+            int c = occurrences[o];
+            if (satisfied[c])
+                continue;
+            if (--count[c] == 0)
+                return UNSAT;
+            if (count[c] > 1)
+                continue;
+            // The last literal not false: true already, or implied (none
+            // if a literal is repeated: its next occurrence falsifies c)
+            const int* p = &literals[starts[c]];
+            while (*p && value(*p) < 0)
+                p++;
+            if (*p && !value(*p)) {
+                values[std::abs(*p)] = *p > 0 ? 1 : -1;
+                trail.push_back(*p);
+            }
+        }
+    }
+    return SAT;
+}
+
+// -----------------------------------------------------------------------------
+// Completes the values with phase into model
+int Tractable::complete(int* model, int phase) const {
+    for (int var = 1; var <= formula.getVars(); var++)
+        model[var] = values[var] ? values[var] > 0 : phase;
+    return formula.check(model) < 0 ? SAT : UNKNOWN;
+}
+
+// -----------------------------------------------------------------------------
+// The name of fragment
+const char* Tractable::name(Fragment fragment) {
+    switch (fragment) {
+    case Fragment::units:
+        return "units";
+    case Fragment::binary:
+        return "2-sat";
+    case Fragment::horn:
+        return "horn";
+    case Fragment::dual:
+        return "dual-horn";
+    default:
+        return "general";
+    }
+}
@@ -0,0 +1,71 @@
+//  ----------------------------------------------------------------------------
+//  Header file for the Tractable class.                           tractable.hpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#ifndef MICROSAT_TRACTABLE_HPP
+#define MICROSAT_TRACTABLE_HPP
+
+#include "formula.hpp"
+#include <cstdlib>
+#include <vector>
+
+namespace microsat {
+
+// -----------------------------------------------------------------------------
+// Fast paths for the fragments of CNF decided in linear time, tried after
+// parsing instead of the search:
+//   - 2-CNF: the strongly connected components of the implication graph
+//     (Aspvall, Plass & Tarjan, 1979);
+//   - Horn (at most one positive literal per clause) and dual Horn (at most
+//     one negative literal): unit propagation with counters (Dowling &
+//     Gallier, 1984), the variables it leaves unassigned false (true for
+//     dual Horn);
+//   - formulas with unit clauses: the same propagation decides them when
+//     it fails, or when it leaves every clause satisfied by one of the two
+//     phases.
+class Tractable {
+  public:
+    enum class Fragment { general, units, binary, horn, dual };
+
+  private:
+    const Formula& formula;
+    std::vector<int> offsets;     // Of the occurrences of each literal
+    std::vector<int> occurrences; // Clauses (or implied literals for 2-CNF)
+    std::vector<int> values;      // Of the variables: 1, -1, 0 unassigned
+
+    // Index of literal in offsets: 2 var, plus 1 if negative
+    static int index(int literal) {
+        return 2 * std::abs(literal) + (literal < 0);
+    }
+    int value(int literal) const {
+        return literal > 0 ? values[literal] : -values[-literal];
+    }
+    // Decides the formula of fragment, writing to model whatever the result
+    int decide(Fragment fragment, int* model);
+    // Decides a 2-CNF formula
+    int binary(int* model);
+    // Propagates the unit clauses; returns UNSAT on a conflict
+    int propagate();
+    // Writes the values to model, the unassigned variables set to phase;
+    // returns SAT if it satisfies the formula, otherwise UNKNOWN
+    int complete(int* model, int phase) const;
+
+  public:
+    explicit Tractable(const Formula& formula) : formula(formula) {}
+
+    // The fragment of the formula (units: it has unit clauses, which may
+    // decide it)
+    [[nodiscard]] Fragment classify() const;
+    // Decides the formula of fragment: returns SAT (writing the value of
+    // every variable v to model[v]) or UNSAT, or UNKNOWN if it is not
+    // decided after all (units); model is only written if SAT
+    int solve(Fragment fragment, int* model);
+    // The name of fragment, for the statistics
+    static const char* name(Fragment fragment);
+};
+
+} // namespace microsat
+
+#endif // MICROSAT_TRACTABLE_HPP
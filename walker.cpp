@@ -0,0 +1,208 @@
+//  ----------------------------------------------------------------------------
+//  Implementation file for the Walker class.                         walker.cpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#include "walker.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+using namespace microsat;
+
+// -----------------------------------------------------------------------------
+// Copies the clauses of formula into flat arrays
+Walker::Walker(const Formula& formula, std::uint64_t seed)
+    : nVars(formula.getVars()), seed(seed ? seed : 1) {
+    const int n = nVars;
+    start.push_back(0);
+    std::vector<int> clause;
+    int size_max = 0;
+    for (int literal : formula.getLiterals()) {
+        if (literal) {
+            clause.push_back(literal);
+            continue;
+        }
+        // Remove duplicate literals (the counts rely on it) and tautologies
+        std::sort(clause.begin(), clause.end());
+        clause.erase(std::unique(clause.begin(), clause.end()), clause.end());
+        bool tautology = false;
+        for (int lit : clause)
+            tautology |= std::binary_search(clause.begin(), clause.end(), -lit);
+        if (!tautology) {
+            literals.insert(literals.end(), clause.begin(), clause.end());
+            start.push_back((int)literals.size());
+            size_max = std::max(size_max, (int)clause.size());
+            nClauses++;
+        }
+        clause.clear();
+    }
+    // Occurrence lists by counting sort on the literals
+    occurs_start.assign(2 * n + 2, 0);
+    for (int literal : literals)
+        occurs_start[literal + n + 1]++;
+    for (int i = 1; i < 2 * n + 2; i++)
+        occurs_start[i] += occurs_start[i - 1];
+    occurs.resize(literals.size());
+    std::vector<int> fill(occurs_start.begin(), occurs_start.end() - 1);
+    for (int c = 0; c < nClauses; c++)
+        for (int i = start[c]; i < start[c + 1]; i++)
+            occurs[fill[literals[i] + n]++] = c;
+    true_count.assign(nClauses, 0);
+    true_sum.assign(nClauses, 0);
+    unsat_pos.assign(nClauses, -1);
+    breaks.assign(n + 1, 0);
+    value.assign(n + 1, 0);
+    best.assign(n + 1, 0);
+    scores.resize(size_max);
+    // ProbSAT scores: polynomial in the break value for 3-SAT, exponential
+    // (with a base growing with the clause length) for longer clauses
+    probability.resize(64);
+    for (int b = 0; b < (int)probability.size(); b++)
+        if (size_max <= 3)
+            probability[b] = std::pow(0.9 + b, -2.06);
+        else
+            probability[b] =
+                std::pow(size_max == 4 ? 3.0 : size_max == 5 ? 3.7 : 5.1, -b);
+}
+
+// -----------------------------------------------------------------------------
+// Returns the next pseudo-random number (xorshift64)
+std::uint64_t Walker::random() {
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    return seed;
+}
+
+// -----------------------------------------------------------------------------
+// Starts from phases (phases[v] non-zero iff v is true)
+void Walker::init(const int* phases) {
+    for (int v = 1; v <= nVars; v++)
+        value[v] = phases[v] != 0;
+    std::fill(breaks.begin(), breaks.end(), 0);
+    unsat.clear();
+    for (int c = 0; c < nClauses; c++) {
+        int count = 0, sum = 0;
+        for (int i = start[c]; i < start[c + 1]; i++) {
+            int literal = literals[i];
+            if ((literal > 0) == (value[std::abs(literal)] != 0)) {
+                count++;
+                sum += std::abs(literal);
+            }
+        }
+        true_count[c] = count;
+        true_sum[c] = sum;
+        unsat_pos[c] = -1;
+        if (count == 0) {
+            unsat_pos[c] = (int)unsat.size();
+            unsat.push_back(c);
+        } else if (count == 1) {
+            breaks[sum]++; // The only true variable is critical
+        }
+    }
+    best = value;
+    best_unsat = unsat.size();
+    trail.clear();
+    tracking = true;
+}
+
+// -----------------------------------------------------------------------------
+// Flips the variable updating counts, breaks and the falsified list
+void Walker::flip(int var) {
+    const int n = nVars;
+    int fell = value[var] ? var : -var; // The literal becoming false
+    value[var] ^= 1;
+    for (int i = occurs_start[fell + n]; i < occurs_start[fell + n + 1]; i++) {
+        int c = occurs[i];
+        true_sum[c] -= var;
+        if (--true_count[c] == 0) { // var was critical
+            breaks[var]--;
+            unsat_pos[c] = (int)unsat.size();
+            unsat.push_back(c);
+        } else if (true_count[c] == 1) { // The remaining one is critical now
+            breaks[true_sum[c]]++;
+        }
+    }
+    for (int i = occurs_start[-fell + n]; i < occurs_start[-fell + n + 1];
+         i++) {
+        int c = occurs[i];
+        true_sum[c] += var;
+        if (++true_count[c] == 1) { // var is critical
+            breaks[var]++;
+            int last = unsat.back(); // Swap the clause out of the list
+            unsat[unsat_pos[c]] = last;
+            unsat_pos[last] = unsat_pos[c];
+            unsat.pop_back();
+            unsat_pos[c] = -1;
+        } else if (true_count[c] == 2) { // The other one is no more critical
+            breaks[true_sum[c] - var]--;
+        }
+    }
+    // Remember the flips since the best assignment while they are few
+    if (tracking) {
+        if ((int)trail.size() < nVars / 4 + 16)
+            trail.push_back(var);
+        else
+            tracking = false;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Flips until no clause is falsified or budget flips are done
+std::size_t Walker::walk(long long budget) {
+    const int cap = (int)probability.size() - 1;
+    for (long long done = 0; !unsat.empty() && (budget < 0 || done < budget);
+         done++) {
+        int c = unsat[random() % unsat.size()];
+        if (start[c] == start[c + 1])
+            break; // An empty clause can't be satisfied
+        // Score the variables of the clause by their break values
+        double total = 0;
+        for (int i = start[c]; i < start[c + 1]; i++) {
+            int b = std::min(breaks[std::abs(literals[i])], cap);
+            total += scores[i - start[c]] = probability[b];
+        }
+        double pick = (double)(random() >> 11) * 0x1.0p-53 * total;
+        int i = start[c];
+        while (i + 1 < start[c + 1] && (pick -= scores[i - start[c]]) > 0)
+            i++;
+        flip(std::abs(literals[i]));
+        flips++;
+        if (unsat.size() < best_unsat) {
+            // Bring best up to date: replay the flips or copy everything
+            if (tracking)
+                for (int var : trail)
+                    best[var] = value[var];
+            else
+                best = value;
+            best_unsat = unsat.size();
+            trail.clear();
+            tracking = true;
+        }
+    }
+    return best_unsat;
+}
+
+// -----------------------------------------------------------------------------
+// Writes the best assignment into phases
+void Walker::getBest(int* phases) const {
+    for (int v = 1; v <= nVars; v++)
+        phases[v] = best[v];
+}
+
+// -----------------------------------------------------------------------------
+// Phase provider for Solver::walker
+std::function<bool(int*)> Walker::provider(const Formula& formula,
+                                           long long budget) {
+    std::uint64_t calls = 0; // Every walk gets its own seed
+    return [&formula, budget, calls](int* phases) mutable {
+        Walker walker(formula, ++calls);
+        walker.init(phases);
+        walker.walk(budget);
+        walker.getBest(phases);
+        return true;
+    };
+}
@@ -0,0 +1,75 @@
+//  ----------------------------------------------------------------------------
+//  Header file for the Walker class.                                 walker.hpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#ifndef MICROSAT_WALKER_HPP
+#define MICROSAT_WALKER_HPP
+
+#include "formula.hpp"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace microsat {
+
+// -----------------------------------------------------------------------------
+// ProbSAT stochastic local search. The clauses are copied into flat arrays;
+// every clause keeps the number of its true literals and the sum of its true
+// variables (which is the critical variable when only one is true), every
+// variable its cached break value, and the falsified clauses are kept in a
+// list with the position of each clause in it. A flip picks a random
+// falsified clause and one of its variables with a probability decreasing
+// with the break value. Local search can only find models: it never proves
+// unsatisfiability.
+class Walker {
+  private:
+    int nVars;                     // The number of variables
+    int nClauses = 0;              // The number of clauses (no tautologies)
+    std::vector<int> literals;     // The literals of all clauses
+    std::vector<int> start;        // Clause c is literals[start[c]..start[c+1])
+    std::vector<int> occurs;       // Clauses of each literal, by literal
+    std::vector<int> occurs_start; // Literal l has occurs[occurs_start[l+n]..]
+    std::vector<int> true_count;   // Number of true literals of each clause
+    std::vector<int> true_sum;     // Sum of the true variables of each clause
+    std::vector<int> breaks;       // Clauses only satisfied by each variable
+    std::vector<int> unsat;        // The falsified clauses
+    std::vector<int> unsat_pos;    // Position of each clause in unsat
+    std::vector<char> value;       // The current assignment
+    std::vector<char> best;        // The assignment with fewest falsified
+    std::size_t best_unsat = 0;    // Number of clauses falsified by best
+    std::vector<int> trail;        // Variables flipped since best was saved
+    bool tracking = true;          // Whether trail holds all of those flips
+    std::vector<double> probability; // Score of each (capped) break value
+    std::vector<double> scores;      // Scores of the picked clause
+    std::uint64_t seed;              // State of the random generator
+    long long flips = 0;             // Number of flips so far
+
+    // Returns the next pseudo-random number (xorshift64)
+    std::uint64_t random();
+    // Flips the variable updating counts, breaks and the falsified list
+    void flip(int var);
+
+  public:
+    explicit Walker(const Formula& formula, std::uint64_t seed = 1);
+
+    // Starts from phases (phases[v] non-zero iff v is true)
+    void init(const int* phases);
+    // Flips until no clause is falsified or budget flips are done (negative:
+    // no limit); returns the number of clauses falsified by best
+    std::size_t walk(long long budget);
+    // Writes the best assignment into phases
+    void getBest(int* phases) const;
+
+    [[nodiscard]] long long getFlips() const { return flips; }
+
+    // Phase provider for Solver::walker: walks budget flips from the phases
+    // it is given on the current clauses of formula and returns the best
+    static std::function<bool(int*)> provider(const Formula& formula,
+                                              long long budget = 1 << 18);
+};
+
+} // namespace microsat
+
+#endif // MICROSAT_WALKER_HPP
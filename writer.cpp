@@ -0,0 +1,102 @@
+//  ----------------------------------------------------------------------------
+//  Implementation file for the Writer class.                         writer.cpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#include "writer.hpp"
+#include "solver.hpp"
+
+#include <charconv>
+
+using namespace microsat;
+
+// -----------------------------------------------------------------------------
+// Appends a raw string
+void Writer::text(const char* str) {
+    buffer += str;
+    if (buffer.size() >= capacity)
+        flush();
+}
+
+// -----------------------------------------------------------------------------
+// Appends a comment line ("c ...")
+void Writer::comment(const char* str) {
+    buffer += "c ";
+    buffer += str;
+    buffer += '\n';
+    if (buffer.size() >= capacity)
+        flush();
+}
+
+// -----------------------------------------------------------------------------
+// Appends the solution line for SAT, UNSAT, or UNKNOWN
+void Writer::status(int result) {
+    if (result == SAT)
+        buffer += "s SATISFIABLE\n";
+    else if (result == UNSAT)
+        buffer += "s UNSATISFIABLE\n";
+    else
+        buffer += "s UNKNOWN\n";
+}
+
+// -----------------------------------------------------------------------------
+// Appends the model as "v" lines terminated by 0
+void Writer::model(const int* model, int nVars) {
+    values(model, nullptr, nVars);
+}
+
+// -----------------------------------------------------------------------------
+// Appends the model on the variables vars as "v" lines terminated by 0
+void Writer::model(const int* model, const std::vector<int>& vars) {
+    values(model, vars.data(), (int)vars.size());
+}
+
+// -----------------------------------------------------------------------------
+// Appends the values of the size variables vars (1 to size if nullptr) as
+// "v" lines terminated by 0
+void Writer::values(const int* model, const int* vars, int size) {
+    char number[16];
+    std::size_t line = buffer.size(); // start of the current "v" line
+    buffer += "v";
+    for (int i = 1; i <= size + 1; i++) {
+        // The terminating 0 is printed like a literal
+        int var = i > size ? 0 : (vars ? vars[i - 1] : i);
+        int literal = var && model[var] ? var : -var;
+        auto end = std::to_chars(number, number + sizeof number, literal).ptr;
+        std::size_t length = end - number;
+        // Start a new line when the current one would get too long
+        if (buffer.size() - line + 1 + length > line_max) {
+            buffer += "\n";
+            if (buffer.size() >= capacity)
+                flush();
+            line = buffer.size();
+            buffer += "v";
+        }
+        buffer += ' ';
+        buffer.append(number, length);
+    }
+    buffer += '\n';
+    if (buffer.size() >= capacity)
+        flush();
+}
+
+// -----------------------------------------------------------------------------
+// Writes out the buffer
+void Writer::flush() {
+    if (!buffer.empty()) {
+        std::fwrite(buffer.data(), 1, buffer.size(), out);
+        std::fflush(out);
+        buffer.clear();
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Exit code of the competition format for result (10, 20, or 0)
+int Writer::exitCode(int result) {
+    if (result == SAT)
+        return 10;
+    if (result == UNSAT)
+        return 20;
+    return 0;
+}
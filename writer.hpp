@@ -0,0 +1,51 @@
+//  ----------------------------------------------------------------------------
+//  Header file for the Writer class.                                 writer.hpp
+//  Created on October 19, 2026.
+//  Copyright (c) 2019 Yale University. All rights reserved.
+// -----------------------------------------------------------------------------
+
+#ifndef MICROSAT_WRITER_HPP
+#define MICROSAT_WRITER_HPP
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace microsat {
+
+// -----------------------------------------------------------------------------
+// Buffered output in SAT-competition format. Everything is collected in one
+// large buffer and handed to the stream with a single write.
+class Writer {
+  private:
+    const static std::size_t capacity = 1u << 20u; // flush threshold
+    const static int line_max = 78; // maximum length of a "v" line
+    FILE* out;
+    std::string buffer;
+
+    // Appends the values of the size variables vars (1 to size if nullptr)
+    void values(const int* model, const int* vars, int size);
+
+  public:
+    explicit Writer(FILE* out = stdout) : out(out) { buffer.reserve(capacity); }
+    ~Writer() { flush(); }
+
+    // Appends a raw string
+    void text(const char* str);
+    // Appends a comment line ("c ...")
+    void comment(const char* str);
+    // Appends the solution line for SAT, UNSAT, or UNKNOWN
+    void status(int result);
+    // Appends the model as "v" lines terminated by 0 (model[v] != 0: true)
+    void model(const int* model, int nVars);
+    // Appends the model on the variables vars (a projection) likewise
+    void model(const int* model, const std::vector<int>& vars);
+    // Writes out the buffer
+    void flush();
+    // Exit code of the competition format for result (10, 20, or 0)
+    static int exitCode(int result);
+};
+
+} // namespace microsat
+
+#endif // MICROSAT_WRITER_HPP